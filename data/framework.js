@@ -9,6 +9,18 @@ class Framework {
     reconnectAttempts = 0;
     maxReconnectAttempts = 5;
     reconnectDelay = 3000;
+    reconnectMaxDelay = 30000;
+    spa = false;
+    route = window.location.pathname;
+    url = window.location.pathname + window.location.search;
+    boot = undefined;
+    historyBound = false;
+    cache = new Map();
+    maxCachedPages = 8;
+    nextRequestId = 1;
+    pending = new Map();
+    requestTimeout = 10000;
+    listeners = {};
 
     /**
      * Initializes a new instance of the class and establishes a WebSocket connection
@@ -18,6 +30,344 @@ class Framework {
      */
     constructor() {
         this.connect("ws://" + window.location.hostname + "/ws");
+
+        // Intercept Links to the same Host in SPA mode.
+        document.addEventListener('click', (event) => this.onLinkClick(event));
+
+        // Build client rendered Pages once the Document is parsed.
+        if (document.readyState === 'loading') {
+            document.addEventListener('DOMContentLoaded', () => this.renderInitialTree());
+        } else {
+            this.renderInitialTree();
+        }
+    }
+
+    /**
+     * Builds the DOM of a client rendered page from the component tree embedded in the document.
+     *
+     * @return {void}
+     */
+    renderInitialTree() {
+        const data = document.getElementById('bf-tree');
+
+        if (!data) {
+            return;
+        }
+
+        document.getElementById('bf-root').replaceChildren(this.build(JSON.parse(data.textContent)));
+
+        // The Welcome Packet may have arrived before the Elements existed.
+        this.bind(this.listeners);
+    }
+
+    /**
+     * Turns a compact component tree into DOM elements.
+     *
+     * Nodes are arrays of indices into the string table: [tag, id, class, [attribute, value, ...], content],
+     * the content is a string index (inner HTML) or an array of child nodes. Trailing fields may be omitted.
+     *
+     * @param {{s: string[], t: Array}} tree The tree sent by the server.
+     * @return {DocumentFragment} The elements of all top level nodes.
+     */
+    build(tree) {
+        const strings = tree.s;
+
+        const create = (node) => {
+            const element = document.createElement(strings[node[0]]);
+            const attributes = node[3] || [];
+
+            if (node[1]) {
+                element.id = strings[node[1]];
+            }
+
+            if (node[2]) {
+                element.className = strings[node[2]];
+            }
+
+            for (let i = 0; i < attributes.length; i += 2) {
+                element.setAttribute(strings[attributes[i]], strings[attributes[i + 1]]);
+            }
+
+            if (Array.isArray(node[4])) {
+                for (const child of node[4]) {
+                    element.appendChild(create(child));
+                }
+            } else if (node[4]) {
+                element.innerHTML = strings[node[4]];
+            }
+
+            return element;
+        };
+
+        const fragment = document.createDocumentFragment();
+
+        for (const node of tree.t) {
+            fragment.appendChild(create(node));
+        }
+
+        return fragment;
+    }
+
+    /**
+     * Handles the Back and Forward buttons in SPA mode, registered once the server enabled it.
+     *
+     * @return {void}
+     */
+    onPopState() {
+        const url = window.location.pathname + window.location.search;
+
+        // Only the Hash changed (e.g. an Anchor), the Browser scrolls by itself.
+        if (url === this.url) {
+            return;
+        }
+
+        this.navigate(url, false);
+    }
+
+    /**
+     * Navigates to the given URL. In SPA mode the page is requested over the
+     * existing WebSocket, a cached copy is shown immediately while the server
+     * confirms its version. Without SPA mode a normal document load is done.
+     *
+     * @param {string} url The path (and query) of the page to show.
+     * @param {boolean} push Whether a new history entry should be created.
+     * @return {void}
+     */
+    navigate(url, push = true) {
+        if (!this.spa || !this.isConnected) {
+            window.location.href = url;
+            return;
+        }
+
+        if (push) {
+            history.pushState({url: url}, '', url);
+        }
+
+        // Pages are registered by Path, the Query stays in the Address Bar for the Page.
+        const route = new URL(url, window.location.href).pathname;
+
+        this.route = route;
+        this.url = url;
+
+        // Show cached Fragment while waiting for the Server.
+        const cached = this.cache.get(route);
+
+        if (cached) {
+            this.renderPage(cached);
+        }
+
+        this.sendPacket("navigate", {
+            "route": route,
+            "fragment": true,
+            "version": cached ? cached.version : 0
+        });
+    }
+
+    /**
+     * Handles clicks on links and turns them into SPA navigations if possible.
+     *
+     * @param {MouseEvent} event The click event.
+     * @return {void}
+     */
+    onLinkClick(event) {
+        if (!this.spa || event.defaultPrevented || event.button !== 0 ||
+            event.metaKey || event.ctrlKey || event.shiftKey || event.altKey) {
+            return;
+        }
+
+        const link = event.target.closest('a');
+
+        if (!link || link.target || link.hasAttribute('download') || link.origin !== window.location.origin) {
+            return;
+        }
+
+        // Anchors on the current Page are handled by the Browser.
+        if (link.hash && link.pathname === window.location.pathname && link.search === window.location.search) {
+            return;
+        }
+
+        event.preventDefault();
+
+        this.navigate(link.pathname + link.search);
+    }
+
+    /**
+     * Replaces the content of the page root with the given cached page.
+     *
+     * @param {{title: string, body: string, tree: Object}} page The page to show, client rendered pages carry a tree.
+     * @return {void}
+     */
+    renderPage(page) {
+        document.title = page.title;
+
+        if (page.tree) {
+            document.getElementById('bf-root').replaceChildren(this.build(page.tree));
+        } else {
+            document.getElementById('bf-root').innerHTML = page.body;
+        }
+    }
+
+    /**
+     * Handles a page packet received as response to a SPA navigation.
+     *
+     * @param {Object} value The value of the page packet.
+     * @return {void}
+     */
+    onPage(value) {
+        // Ignore responses of Navigations which are already outdated.
+        if (value.route !== this.route) {
+            return;
+        }
+
+        if (!value.found) {
+            window.location.href = this.url;
+            return;
+        }
+
+        let page = this.cache.get(value.route);
+
+        // Server is over its Render Budget, ask again later and keep the cached Copy meanwhile.
+        if (value.retryAfter !== undefined) {
+            setTimeout(() => {
+                if (this.route === value.route) {
+                    this.navigate(this.url, false);
+                }
+            }, value.retryAfter * 1000);
+
+            if (!page) {
+                return;
+            }
+        }
+
+        if (value.body !== undefined || value.tree !== undefined) {
+            page = {version: value.version, title: value.title, body: value.body, tree: value.tree};
+
+            this.renderPage(page);
+        }
+
+        // Refresh Position in LRU Cache.
+        this.cache.delete(value.route);
+        this.cache.set(value.route, page);
+
+        if (this.cache.size > this.maxCachedPages) {
+            this.cache.delete(this.cache.keys().next().value);
+        }
+
+        this.bind(value.listeners);
+    }
+
+    /**
+     * Collects the current state of a form element, so listeners can store it.
+     *
+     * Forms collect the state of all of their fields in one object keyed by field id.
+     *
+     * @param {HTMLElement} element The element which fired the event.
+     * @return {Object|string} The checked state of checkboxes, the value of other inputs or an empty string.
+     */
+    collect(element) {
+        if (element.tagName === 'FORM') {
+            const values = {};
+
+            for (const field of element.elements) {
+                if (field.id && field.tagName !== 'BUTTON') {
+                    values[field.id] = field.type === 'checkbox' ? field.checked : field.value;
+                }
+            }
+
+            return {"values": values};
+        }
+
+        if (element.type === 'checkbox') {
+            return {"checked": element.checked};
+        }
+
+        if (element.value !== undefined && element.tagName !== 'BUTTON') {
+            return {"value": element.value};
+        }
+
+        return "";
+    }
+
+    /**
+     * Applies the values of bound components pushed by the server.
+     *
+     * @param {Object<string, string>} values Map of component ids to their new state.
+     * @return {void}
+     */
+    update(values) {
+        for (const [key, state] of Object.entries(values)) {
+            const element = document.getElementById(key);
+
+            if (!element) {
+                continue;
+            }
+
+            if (element.type === 'checkbox') {
+                element.checked = state === '1' || state === 'true';
+            } else if (element.tagName === 'INPUT' || element.tagName === 'TEXTAREA' || element.tagName === 'SELECT') {
+                element.value = state;
+            } else {
+                element.innerHTML = state;
+            }
+        }
+    }
+
+    /**
+     * Registers the listeners announced by the server on the DOM elements.
+     * Elements which already have a listener for an action are skipped, so
+     * repeated welcome packets after a reconnect do not fire events twice.
+     *
+     * @param {Object<string, string[]>} listeners Map of component ids to event types.
+     * @return {void}
+     */
+    bind(listeners) {
+        this.listeners = listeners;
+
+        for (const [key, actions] of Object.entries(listeners || {})) {
+            const element = document.getElementById(key);
+
+            if (!element) {
+                continue;
+            }
+
+            element.bound = element.bound || new Set();
+
+            for (const action of actions) {
+                if (element.bound.has(action)) {
+                    continue;
+                }
+
+                element.bound.add(action);
+
+                element.addEventListener(action, (event) => {
+                    // Forms are submitted over the WebSocket only.
+                    if (action === 'submit') {
+                        event.preventDefault();
+                    }
+
+                    // - Client: {"type": "execute", "value": {"route": "/", "component": "test123","event": "change", "data": {"value": "xyz"}}}
+                    const value = {
+                        "route": this.route,
+                        "component": key,
+                        "event": action,
+                        "data": this.collect(element)
+                    };
+
+                    // High frequency Events (e.g. Sliders) are fire and forget unless the Element asks for an Ack.
+                    const ack = element.dataset.ack !== undefined ? element.dataset.ack !== 'false' : action !== 'input';
+
+                    if (ack) {
+                        this.request("execute", value)
+                            .then((result) => element.dispatchEvent(new CustomEvent('framework:result', {detail: result})))
+                            .catch((error) => console.error('Event failed:', error));
+                    } else {
+                        this.sendPacket("execute", value, {"ack": false});
+                    }
+                });
+
+                console.log(key, action);
+            }
+        }
     }
 
     /**
@@ -26,10 +376,12 @@ class Framework {
      *
      * @param {string} type The type of the packet to be sent.
      * @param {*} value The value associated with the packet.
+     * @param {Object} options Additional top level fields of the packet (e.g. {"ack": false}).
      * @return {void} This method does not return any value.
      */
-    sendPacket(type, value) {
+    sendPacket(type, value, options = {}) {
         const packet = JSON.stringify({
+            ...options,
             "type": type,
             "value": value
         });
@@ -39,6 +391,67 @@ class Framework {
         console.log('Sent packet:', packet);
     }
 
+    /**
+     * Sends a packet with a request id and returns a promise for the response.
+     * Any number of requests may be outstanding at the same time, responses are
+     * matched by the id the server echoes.
+     *
+     * @param {string} type The type of the packet to be sent.
+     * @param {*} value The value associated with the packet.
+     * @return {Promise<*>} Resolves with the result of the listener, rejects on errors or timeouts.
+     */
+    request(type, value) {
+        const id = this.nextRequestId++;
+
+        return new Promise((resolve, reject) => {
+            const timer = setTimeout(() => {
+                this.pending.delete(id);
+                reject(new Error('Request ' + id + ' timed out'));
+            }, this.requestTimeout);
+
+            this.pending.set(id, {resolve, reject, timer});
+
+            this.sendPacket(type, value, {"id": id, "ack": true});
+        });
+    }
+
+    /**
+     * Settles the pending request the given packet answers.
+     *
+     * @param {Object} data The received packet.
+     * @return {void}
+     */
+    settle(data) {
+        const request = this.pending.get(data.id);
+
+        if (!request) {
+            return;
+        }
+
+        this.pending.delete(data.id);
+        clearTimeout(request.timer);
+
+        if (data.type === 'message' && data.value.status === 'error') {
+            request.reject(new Error(data.value.message));
+        } else {
+            request.resolve(data.value.result !== undefined ? data.value.result : data.value);
+        }
+    }
+
+    /**
+     * Rejects all pending requests, e.g. when the connection was lost.
+     *
+     * @return {void}
+     */
+    rejectPending() {
+        for (const request of this.pending.values()) {
+            clearTimeout(request.timer);
+            request.reject(new Error('Connection closed'));
+        }
+
+        this.pending.clear();
+    }
+
     /**
      * Establishes a WebSocket connection to the specified URL.
      *
@@ -57,7 +470,7 @@ class Framework {
 
                 // Request Welcome Packet.
                 this.sendPacket("navigate", {
-                    "route": window.location.pathname
+                    "route": this.route
                 });
             };
 
@@ -66,34 +479,57 @@ class Framework {
                     const data = JSON.parse(event.data);
                     const value = data.value;
 
+                    // Response to a Request of this Client.
+                    if (data.id !== undefined) {
+                        this.settle(data);
+                    }
+
                     // Switch through incoming packets.
                     switch (data.type) {
                         case 'config':
-                            this.maxReconnectAttempts = value.maxReconnectAttempts;
-                            this.reconnectDelay = value.reconnectDelay;
+                            if (value.maxReconnectAttempts !== undefined) {
+                                this.maxReconnectAttempts = value.maxReconnectAttempts;
+                            }
+
+                            if (value.reconnectDelay !== undefined) {
+                                this.reconnectDelay = value.reconnectDelay;
+                            }
+
+                            if (value.reconnectMaxDelay !== undefined) {
+                                this.reconnectMaxDelay = value.reconnectMaxDelay;
+                            }
+
+                            this.spa = !!value.spa;
+
+                            // Page Versions restart with every Boot of the Device, cached Pages may be outdated.
+                            if (this.boot !== undefined && this.boot !== value.boot) {
+                                this.cache.clear();
+                            }
+
+                            this.boot = value.boot;
+
+                            // Handle Back and Forward Buttons, without SPA Mode the Browser does it.
+                            if (this.spa && !this.historyBound) {
+                                window.addEventListener('popstate', () => this.onPopState());
+                                this.historyBound = true;
+                            }
                             break;
                         case 'welcome':
                             // Register Listeners {"type":"welcome","value":{"Click me!":["click"]}}).
                             console.log('Welcome message received');
 
-                            for (const [key, actions] of Object.entries(value)) {
-                                for (const action of actions) {
-                                    document.getElementById(key).addEventListener(action, () => {
-                                        // - Client: {"type": "execute", "value": {"route": "/", "component": "test123","event": "click", "data": "xyz" }}
-                                        this.sendPacket("execute", {
-                                            "route": window.location.pathname,
-                                            "component": key,
-                                            "event": action,
-                                            "data": ""
-                                        });
-                                    });
-
-                                    console.log(key, action);
-                                }
-                            }
+                            this.bind(value);
 
                             console.log(value);
                             break;
+                        case 'page':
+                            // Fragment and Listeners of a SPA Navigation.
+                            this.onPage(value);
+                            break;
+                        case 'update':
+                            // Values of bound Components {"type":"update","value":{"temperature":"21.5"}}.
+                            this.update(value);
+                            break;
                         case 'message':
                             console.log(value.message);
                             break;
@@ -102,7 +538,7 @@ class Framework {
                             eval(value.value);
                             break;
                         case 'ping':
-                            this.ws.send('pong');
+                            this.sendPacket("pong", {});
                             break;
                     }
 
@@ -118,6 +554,7 @@ class Framework {
 
             this.ws.onclose = () => {
                 this.isConnected = false;
+                this.rejectPending();
                 console.log('WebSocket connection closed');
                 this.reconnect(url);
             };
@@ -130,19 +567,23 @@ class Framework {
 
     /**
      * Attempts to reconnect to the specified URL if the maximum number of reconnection attempts has not been reached.
-     * Each reconnection attempt is delayed by a specified timeout.
+     * The delay grows exponentially with every attempt (capped by the limit advertised by the server) and is
+     * randomized, so clients do not all reconnect at the same time after the device rebooted.
      *
      * @param {string} url - The URL to which the reconnection should be attempted.
      * @return {void} This method does not return a value.
      */
     reconnect(url) {
         if (this.reconnectAttempts < this.maxReconnectAttempts) {
+            const limit = Math.min(this.reconnectMaxDelay, this.reconnectDelay * Math.pow(2, this.reconnectAttempts));
+            const delay = Math.round(limit / 2 + Math.random() * limit / 2);
+
             this.reconnectAttempts++;
-            console.log(`Reconnecting... Attempt ${this.reconnectAttempts} of ${this.maxReconnectAttempts}`);
+            console.log(`Reconnecting in ${delay} ms... Attempt ${this.reconnectAttempts} of ${this.maxReconnectAttempts}`);
 
             setTimeout(() => {
                 this.connect(url);
-            }, this.reconnectDelay);
+            }, delay);
         } else {
             console.error('Max reconnection attempts reached');
         }
@@ -150,4 +591,4 @@ class Framework {
 
 }
 
-new Framework();
\ No newline at end of file
+window.framework = new Framework();
\ No newline at end of file
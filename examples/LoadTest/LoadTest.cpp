@@ -0,0 +1,84 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Target for scripts/loadtest.py, e.g.:
+//   python scripts/loadtest.py --host 192.168.4.1 --clients 8 --duration 30
+//
+// Build with -D BYTEFRAMEWORK_PIPELINE to compare the dual core pipeline mode
+// against the default single task mode.
+//
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include "service/PageService.h"
+#include "core/components/Button.h"
+#include "core/components/Label.h"
+
+AsyncWebServer server(80);
+
+void setup()
+{
+    // Begin Serial.
+    Serial.begin(115200);
+
+    // Setup WiFi AP.
+    WiFi.mode(WIFI_AP);
+    WiFi.softAP("ByteFramework");
+
+    // Begin Page Service.
+    PageService::begin(&server);
+
+    // Allow more Clients than the Default for the Load Test.
+    PageService::setMaxClients(16);
+
+#ifdef BYTEFRAMEWORK_PIPELINE
+    // Dispatch and Serialization on the App Core.
+    PageService::enablePipeline();
+#endif
+
+    auto index = PageService::addPage("/", new Page());
+
+    index->setTitle("ESP32 Load Test");
+
+    // Some static Content to render on every Request.
+    for (int i = 0; i < 20; i++)
+    {
+        index->addComponent(new Label("Row " + String(i)));
+    }
+
+    // Changed by every execute Packet, so Listeners write what concurrent Renders read.
+    auto counter = new Label("Requests: 0");
+
+    index->addComponent(counter);
+
+    // Component receiving execute Packets (measures Dispatch and Response).
+    auto load = index->addComponent(new Button("Load", "load"));
+
+    load->addListener("click", [counter](JsonObject data, JsonObject result)
+    {
+        static uint32_t requests = 0;
+
+        counter->setText("Requests: " + String(++requests));
+        result["uptime"] = millis();
+    });
+
+    // Component whose Listener broadcasts a droppable eval Packet to every Client.
+    auto broadcast = index->addComponent(new Button("Broadcast", "broadcast"));
+
+    broadcast->addListener("click", [](JsonObject data)
+    {
+        PageService::eval("void 0;", true);
+    });
+
+    // Begin Server.
+    server.begin();
+}
+
+// Simple lock to save CPU Bandwith.
+void loop()
+{
+    // Send Heartbeats and release dead Clients.
+    PageService::loop();
+
+    delay(10);
+}
@@ -32,6 +32,12 @@ void setup()
     // Add Label Component.
     index->addComponent(new Label("Test 123"));
 
+    // Add Label showing the Uptime, only sampled while somebody views the Page.
+    index->addComponent(new Label("0", "uptime"))->bind([]
+    {
+        return millis() / 1000;
+    }, 1000);
+
     // Add Button Component.
     auto button = index->addComponent(new Button("submit", "Click me!"));
 
@@ -55,6 +61,24 @@ void setup()
         PageService::eval("alert('Response from Backend!');");
     });
 
+    // Handle the Button of the exported About Page, its Components do not exist at Runtime.
+    PageService::on("/about", "hello", "click", [](JsonObject data)
+    {
+        Serial.println("Hello from the About Page!");
+    });
+
+    // Export a Page which never changes, the Builder only runs if Version 1 was not exported yet.
+    PageService::addStaticPage("/about", 1, []
+    {
+        auto about = new Page();
+
+        about->setTitle("About");
+        about->addComponent(new Label("Built with ByteFramework"));
+        about->addComponent(new Button("Say hello", "hello"));
+
+        return about;
+    });
+
     // Begin Server.
     server.begin();
 }
@@ -62,5 +86,8 @@ void setup()
 // Simple lock to save CPU Bandwith.
 void loop()
 {
+    // Send Heartbeats and release dead Clients.
+    PageService::loop();
+
     delay(100);
 }
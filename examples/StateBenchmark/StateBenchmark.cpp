@@ -0,0 +1,144 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Measures how long StateService::begin() needs to restore the state on startup.
+//
+// For every case the state files are seeded with a snapshot of N keys and a journal of
+// M records, then begin() is timed several times. Each case prints one JSON line, e.g.:
+//   {"keys":256,"records":1024,"snapshotBytes":...,"journalBytes":...,"restored":256,"minUs":...,"medianUs":...}
+//
+// Runs on a device (flash the sketch, read the Serial Monitor) or on the host:
+//   pio run -e native-state && .pio/build/native-state/program --fs /tmp/bf-state
+//
+// Warning: the state files of the filesystem are overwritten.
+//
+#include <Arduino.h>
+#include <SPIFFS.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "service/StateService.h"
+#include "core/components/Label.h"
+
+/**
+ * A seeded filesystem: keys in the snapshot and records in the journal behind it.
+ */
+struct BenchmarkCase
+{
+    size_t keys;
+    size_t records;
+};
+
+// The Journal is compacted at 8 KB by Default, about 170 Records of this Size.
+static const BenchmarkCase CASES[] = {{32, 0}, {32, 160}, {256, 0}, {256, 160}, {256, 1024}, {1024, 1024}};
+
+// Timed begin() Calls per Case.
+static const int RUNS = 5;
+
+/**
+ * Writes a snapshot of the given number of keys and appends the given number of journal records.
+ */
+static void seed(size_t index, const BenchmarkCase& entry)
+{
+    // Start from empty Files and an empty Value Map.
+    SPIFFS.remove("/bf/state.snap");
+    SPIFFS.remove("/bf/state.tmp");
+    SPIFFS.remove("/bf/state.log");
+
+    StateService::begin();
+    StateService::setCompactThreshold(SIZE_MAX);
+
+    std::vector<Label*> labels;
+
+    for (size_t i = 0; i < entry.keys; i++)
+    {
+        auto label = new Label("");
+
+        StateService::track("/case" + String(index) + "/key" + String(i), label);
+        labels.push_back(label);
+    }
+
+    // Snapshot with every Key, 32 Bytes per Value.
+    for (size_t i = 0; i < entry.keys; i++)
+    {
+        labels[i]->setText("snapshot-value-" + String(i + 100000000));
+    }
+
+    StateService::flush();
+    StateService::compact();
+
+    // Journal, written in Batches of 16 Changes like a busy Settings Page.
+    for (size_t i = 0; i < entry.records; i++)
+    {
+        labels[i % entry.keys]->setText("journal--value-" + String(i + 100000000));
+
+        if (i % 16 == 15 || i + 1 == entry.records)
+        {
+            StateService::flush();
+        }
+    }
+
+    StateService::setCompactThreshold(8192);
+}
+
+static size_t fileSize(const char* path)
+{
+    if (!SPIFFS.exists(path))
+    {
+        return 0;
+    }
+
+    File file = SPIFFS.open(path, FILE_READ);
+    const size_t size = file.size();
+
+    file.close();
+
+    return size;
+}
+
+void setup()
+{
+    // Begin Serial.
+    Serial.begin(115200);
+
+    // Mount Filesystem.
+    if (!SPIFFS.begin(true))
+    {
+        Serial.println("Unable to mount SPIFFS");
+        return;
+    }
+
+    for (size_t index = 0; index < sizeof(CASES) / sizeof(CASES[0]); index++)
+    {
+        const BenchmarkCase& entry = CASES[index];
+
+        seed(index, entry);
+
+        std::vector<unsigned long> durations;
+        size_t restored = 0;
+
+        for (int run = 0; run < RUNS; run++)
+        {
+            const unsigned long start = micros();
+
+            restored = StateService::begin();
+            durations.push_back(micros() - start);
+        }
+
+        std::sort(durations.begin(), durations.end());
+
+        Serial.printf("{\"keys\":%u,\"records\":%u,\"snapshotBytes\":%u,\"journalBytes\":%u,\"restored\":%u,"
+                      "\"minUs\":%lu,\"medianUs\":%lu}\n",
+                      (unsigned int)entry.keys, (unsigned int)entry.records,
+                      (unsigned int)fileSize("/bf/state.snap"), (unsigned int)fileSize("/bf/state.log"),
+                      (unsigned int)restored, durations.front(), durations[RUNS / 2]);
+    }
+
+    Serial.println("Done");
+}
+
+void loop()
+{
+    delay(1000);
+}
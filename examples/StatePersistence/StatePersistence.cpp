@@ -0,0 +1,74 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include "service/PageService.h"
+#include "service/StateService.h"
+#include "core/components/Input.h"
+#include "core/components/Checkbox.h"
+#include "core/components/TextArea.h"
+
+AsyncWebServer server(80);
+
+void setup()
+{
+    // Begin Serial.
+    Serial.begin(115200);
+
+    // Setup WiFi AP.
+    WiFi.mode(WIFI_AP);
+    WiFi.softAP("ByteFramework");
+
+    // Begin Page Service (mounts SPIFFS).
+    PageService::begin(&server);
+
+    // Restore persisted State and measure Startup Time.
+    const unsigned long start = micros();
+    const size_t restored = StateService::begin();
+    const unsigned long duration = micros() - start;
+
+    Serial.printf("Restored %u keys in %lu us\n", restored, duration);
+
+    // Build a simple Settings Page.
+    auto index = PageService::addPage("/", new Page());
+
+    index->setTitle("ESP32 Settings");
+
+    // Add Components and persist their State.
+    auto name = (Input*)StateService::track("/name", index->addComponent(new Input("name", "text", "Device name")));
+    auto enabled = (Checkbox*)StateService::track("/enabled", index->addComponent(new Checkbox("enabled")));
+    auto notes = (TextArea*)StateService::track("/notes", index->addComponent(new TextArea("notes")));
+
+    // Store Values sent by the Frontend.
+    name->addListener("change", [name](JsonObject data)
+    {
+        name->setValue(data["value"] | "");
+    });
+
+    enabled->addListener("change", [enabled](JsonObject data)
+    {
+        enabled->setChecked(data["checked"] | false);
+    });
+
+    notes->addListener("change", [notes](JsonObject data)
+    {
+        notes->setValue(data["value"] | "");
+    });
+
+    // Begin Server.
+    server.begin();
+}
+
+// Simple lock to save CPU Bandwith.
+void loop()
+{
+    // Send Heartbeats and release dead Clients.
+    PageService::loop();
+
+    // Write changed States to Flash (coalesced).
+    StateService::loop();
+
+    delay(100);
+}
@@ -0,0 +1,448 @@
+#
+# Load generator for ByteFramework.
+#
+# Opens N simulated WebSocket clients against a device running examples/LoadTest (or any
+# ByteFramework server), replays mixed navigate/execute traffic and HTTP page requests, triggers
+# eval broadcasts and reports latency percentiles, dropped frames and the heap peak of the device.
+#
+# Usage:
+#   python scripts/loadtest.py --host 192.168.4.1 --clients 8 --duration 30
+#   python scripts/loadtest.py --host 192.168.4.1 --save-baseline scripts/baselines/esp32.json
+#   python scripts/loadtest.py --host 192.168.4.1 --baseline scripts/baselines/esp32.json
+#   python scripts/loadtest.py --host 127.0.0.1 --port 8080 --save-baseline /tmp/native.json
+#   python scripts/loadtest.py --host 127.0.0.1 --port 8080 --outstanding 4 --http-ratio 0 --broadcast-ratio 0
+#
+# The last two lines run against the host build of examples/LoadTest (pio run -e native, see test/host/main.cpp).
+#
+# By default every client sends --rate packets per second (open loop), so the throughput only reports the offered
+# load. With --outstanding N every client keeps N requests in flight and sends the next one as soon as a response
+# arrives (closed loop), which saturates the server and measures its real throughput.
+#
+# Only the Python standard library is used, so it runs in the PlatformIO Python environment.
+#
+
+import argparse
+import asyncio
+import base64
+import json
+import os
+import random
+import struct
+import sys
+import time
+
+
+class WebSocket:
+    """Minimal WebSocket client (RFC 6455) for text frames."""
+
+    def __init__(self, reader, writer):
+        self.reader = reader
+        self.writer = writer
+
+    @staticmethod
+    async def connect(host, port, path):
+        reader, writer = await asyncio.open_connection(host, port)
+        key = base64.b64encode(os.urandom(16)).decode()
+
+        writer.write((
+            f"GET {path} HTTP/1.1\r\n"
+            f"Host: {host}:{port}\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            f"Sec-WebSocket-Key: {key}\r\n"
+            "Sec-WebSocket-Version: 13\r\n\r\n"
+        ).encode())
+        await writer.drain()
+
+        status = await reader.readline()
+
+        if b" 101 " not in status:
+            raise ConnectionError(f"Handshake failed: {status!r}")
+
+        # Skip remaining Response Headers.
+        while (await reader.readline()) not in (b"\r\n", b""):
+            pass
+
+        return WebSocket(reader, writer)
+
+    async def send_frame(self, opcode, payload):
+        header = bytes([0x80 | opcode])
+        length = len(payload)
+
+        if length < 126:
+            header += bytes([0x80 | length])
+        elif length < 65536:
+            header += bytes([0x80 | 126]) + struct.pack(">H", length)
+        else:
+            header += bytes([0x80 | 127]) + struct.pack(">Q", length)
+
+        # Client Frames must be masked.
+        mask = os.urandom(4)
+        masked = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+
+        self.writer.write(header + mask + masked)
+        await self.writer.drain()
+
+    async def send(self, packet):
+        await self.send_frame(0x1, json.dumps(packet).encode())
+
+    async def recv(self):
+        """Returns the next text message, answers pings on the way, None on close."""
+        message = b""
+
+        while True:
+            head = await self.reader.readexactly(2)
+            opcode = head[0] & 0x0F
+            length = head[1] & 0x7F
+
+            if length == 126:
+                length = struct.unpack(">H", await self.reader.readexactly(2))[0]
+            elif length == 127:
+                length = struct.unpack(">Q", await self.reader.readexactly(8))[0]
+
+            mask = await self.reader.readexactly(4) if head[1] & 0x80 else None
+            payload = await self.reader.readexactly(length)
+
+            if mask:
+                payload = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+
+            if opcode == 0x8:
+                return None
+            if opcode == 0x9:
+                await self.send_frame(0xA, payload)
+                continue
+            if opcode == 0xA:
+                continue
+
+            message += payload
+
+            if head[0] & 0x80:
+                return message.decode(errors="replace")
+
+    async def close(self):
+        try:
+            await self.send_frame(0x8, struct.pack(">H", 1000))
+        except (ConnectionError, OSError):
+            pass
+
+        self.writer.close()
+
+
+async def fetch_page(host, port, path):
+    """Requests a page over plain HTTP, returns the status code."""
+    reader, writer = await asyncio.open_connection(host, port)
+
+    try:
+        writer.write((
+            f"GET {path} HTTP/1.1\r\n"
+            f"Host: {host}:{port}\r\n"
+            "Accept-Encoding: gzip\r\n"
+            "Connection: close\r\n\r\n"
+        ).encode())
+        await writer.drain()
+
+        status = await reader.readline()
+
+        # Read the whole Response, the Page is rendered while it is sent.
+        await reader.read()
+
+        return int(status.split()[1])
+    finally:
+        writer.close()
+
+
+class Results:
+    def __init__(self):
+        self.latencies = []
+        self.sent = 0
+        self.dropped = 0
+        self.errors = 0
+        self.broadcasts = 0
+        self.evals_expected = 0
+        self.evals_received = 0
+        self.heap_size = 0
+        self.free_heap_samples = []
+        self.connect_failures = 0
+        self.page_latencies = []
+        self.page_errors = 0
+        self.pages_rejected = 0
+
+
+def check_ready(args, results, broadcast_clients, ready):
+    if len(broadcast_clients) + results.connect_failures >= args.clients:
+        ready.set()
+
+
+async def run_client(index, args, results, stop_at, broadcast_clients, ready):
+    try:
+        ws = await WebSocket.connect(args.host, args.port, "/ws")
+    except (ConnectionError, OSError) as error:
+        print(f"Client {index}: {error}", file=sys.stderr)
+        results.connect_failures += 1
+        check_ready(args, results, broadcast_clients, ready)
+        return
+
+    pending = {}
+    next_id = 1
+    rng = random.Random(index)
+
+    # Closed Loop: every Response frees a Slot for the next Request.
+    window = asyncio.Semaphore(args.outstanding) if args.outstanding > 0 else None
+
+    async def pause():
+        if window is None:
+            await asyncio.sleep(rng.expovariate(args.rate))
+        else:
+            await asyncio.sleep(0)
+
+    async def receiver():
+        while True:
+            text = await ws.recv()
+
+            if text is None:
+                return
+
+            packet = json.loads(text)
+
+            if packet.get("type") == "eval":
+                results.evals_received += 1
+
+            request_id = packet.get("id")
+
+            if request_id in pending:
+                results.latencies.append(time.perf_counter() - pending.pop(request_id))
+
+                if window is not None:
+                    window.release()
+
+                if packet.get("type") == "message" and packet["value"].get("status") == "error":
+                    results.errors += 1
+
+    task = asyncio.ensure_future(receiver())
+    broadcast_clients.append(index)
+    check_ready(args, results, broadcast_clients, ready)
+
+    try:
+        # Start once every Client is connected, so that each broadcast expects the right Count.
+        await ready.wait()
+
+        while time.monotonic() < stop_at and not task.done():
+            roll = rng.random()
+
+            if roll < args.http_ratio:
+                # Page Requests render in the Network Task, next to the Listeners of the Worker in Pipeline Mode.
+                started = time.perf_counter()
+
+                try:
+                    status = await fetch_page(args.host, args.port, args.route)
+                except (ConnectionError, OSError, IndexError, ValueError):
+                    status = 0
+
+                if status == 200:
+                    results.page_latencies.append(time.perf_counter() - started)
+                elif status == 503:
+                    results.pages_rejected += 1
+                else:
+                    results.page_errors += 1
+
+                await pause()
+                continue
+
+            roll = rng.random()
+
+            if roll < args.navigate_ratio:
+                packet = {"type": "navigate", "value": {"route": args.route}}
+            elif roll < args.navigate_ratio + args.broadcast_ratio:
+                packet = {"type": "execute", "value": {"route": args.route, "component": args.broadcast_component,
+                                                       "event": args.event, "data": ""}}
+                results.broadcasts += 1
+                results.evals_expected += len(broadcast_clients)
+            else:
+                packet = {"type": "execute", "value": {"route": args.route, "component": args.component,
+                                                       "event": args.event, "data": ""}}
+
+            if window is not None:
+                try:
+                    await asyncio.wait_for(window.acquire(), args.timeout)
+                except asyncio.TimeoutError:
+                    break
+
+            packet["id"] = next_id
+            packet["ack"] = True
+            pending[next_id] = time.perf_counter()
+            next_id += 1
+            results.sent += 1
+
+            await ws.send(packet)
+            await pause()
+
+        # Give outstanding Responses a Chance to arrive.
+        deadline = time.monotonic() + args.timeout
+
+        while pending and time.monotonic() < deadline and not task.done():
+            await asyncio.sleep(0.05)
+    except (ConnectionError, OSError, asyncio.IncompleteReadError):
+        pass
+    finally:
+        broadcast_clients.remove(index)
+        results.dropped += len(pending)
+        task.cancel()
+        await ws.close()
+
+
+async def monitor(args, results, stop_at):
+    """Samples the free heap of the device while the test runs.
+
+    minFreeHeap is the low-water mark since boot, so it is not used: it would charge
+    earlier runs (or the boot itself) to this one.
+    """
+    try:
+        ws = await WebSocket.connect(args.host, args.port, "/ws")
+    except (ConnectionError, OSError):
+        return
+
+    try:
+        while time.monotonic() < stop_at:
+            await ws.send({"type": "stats", "id": 0})
+
+            while True:
+                text = await asyncio.wait_for(ws.recv(), args.timeout)
+
+                if text is None:
+                    return
+
+                packet = json.loads(text)
+
+                if packet.get("type") == "stats":
+                    stats = packet["value"]
+                    results.heap_size = stats.get("heapSize", 0)
+                    results.free_heap_samples.append(stats["freeHeap"])
+                    break
+
+            await asyncio.sleep(args.sample_interval)
+    except (ConnectionError, OSError, asyncio.IncompleteReadError, asyncio.TimeoutError):
+        pass
+    finally:
+        await ws.close()
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(round(p / 100.0 * (len(ordered) - 1))))]
+
+
+def summarize(args, results):
+    received_ratio = results.evals_received / results.evals_expected if results.evals_expected else 1.0
+    samples = results.free_heap_samples
+
+    return {
+        "note": args.note,
+        "clients": args.clients,
+        "duration": args.duration,
+        "rate": args.rate,
+        "outstanding": args.outstanding,
+        "sent": results.sent,
+        "answered": len(results.latencies),
+        "errors": results.errors,
+        "dropped": results.dropped,
+        "droppedBroadcasts": max(0, results.evals_expected - results.evals_received),
+        "broadcastDelivery": round(received_ratio, 4),
+        "connectFailures": results.connect_failures,
+        "p50Ms": round(percentile(results.latencies, 50) * 1000, 2),
+        "p99Ms": round(percentile(results.latencies, 99) * 1000, 2),
+        "throughput": round(len(results.latencies) / args.duration, 2),
+        "pages": len(results.page_latencies),
+        "pageErrors": results.page_errors,
+        "pagesRejected": results.pages_rejected,
+        "pageP99Ms": round(percentile(results.page_latencies, 99) * 1000, 2),
+        "heapPeak": (results.heap_size - min(samples)) if samples else None,
+        "heapSamples": len(samples),
+    }
+
+
+def compare(summary, baseline, tolerance):
+    """Returns a list of regressions against the stored baseline."""
+    regressions = []
+
+    # Open and closed Loop Results are not comparable.
+    for key in ("clients", "rate", "outstanding"):
+        if key in baseline and summary[key] != baseline[key]:
+            regressions.append(f"{key}: {summary[key]} != {baseline[key]} (run with the settings of the baseline)")
+
+    for key in ("p50Ms", "p99Ms", "pageP99Ms", "heapPeak"):
+        if summary.get(key) is not None and baseline.get(key):
+            if summary[key] > baseline[key] * (1 + tolerance):
+                regressions.append(f"{key}: {summary[key]} > {baseline[key]} (+{tolerance:.0%})")
+
+    for key in ("dropped", "droppedBroadcasts", "errors", "pageErrors", "connectFailures"):
+        if summary.get(key, 0) > baseline.get(key, 0):
+            regressions.append(f"{key}: {summary[key]} > {baseline.get(key, 0)}")
+
+    if summary["throughput"] < baseline.get("throughput", 0) * (1 - tolerance):
+        regressions.append(f"throughput: {summary['throughput']} < {baseline['throughput']} (-{tolerance:.0%})")
+
+    return regressions
+
+
+async def main():
+    parser = argparse.ArgumentParser(description="Load test a ByteFramework device over WebSockets.")
+    parser.add_argument("--host", default="192.168.4.1")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--clients", type=int, default=8, help="number of simulated clients")
+    parser.add_argument("--duration", type=float, default=30, help="test duration in seconds")
+    parser.add_argument("--rate", type=float, default=5, help="packets per second and client")
+    parser.add_argument("--outstanding", type=int, default=0,
+                        help="requests each client keeps in flight instead of --rate (closed loop), 0 = open loop")
+    parser.add_argument("--route", default="/")
+    parser.add_argument("--component", default="load", help="component receiving execute packets")
+    parser.add_argument("--broadcast-component", default="broadcast", help="component whose listener calls eval()")
+    parser.add_argument("--event", default="click")
+    parser.add_argument("--http-ratio", type=float, default=0.1, help="share of plain HTTP page requests")
+    parser.add_argument("--navigate-ratio", type=float, default=0.2)
+    parser.add_argument("--broadcast-ratio", type=float, default=0.05)
+    parser.add_argument("--sample-interval", type=float, default=0.25, help="seconds between free heap samples")
+    parser.add_argument("--timeout", type=float, default=5, help="seconds to wait for outstanding responses")
+    parser.add_argument("--baseline", help="compare against this baseline file and fail on regressions")
+    parser.add_argument("--save-baseline", help="store the results as new baseline")
+    parser.add_argument("--note", default="", help="describes the target (board, build, host) in the results")
+    parser.add_argument("--tolerance", type=float, default=0.2, help="allowed relative regression")
+    args = parser.parse_args()
+
+    results = Results()
+    stop_at = time.monotonic() + args.duration
+    broadcast_clients = []
+    ready = asyncio.Event()
+
+    await asyncio.gather(
+        monitor(args, results, stop_at + args.timeout),
+        *(run_client(i, args, results, stop_at, broadcast_clients, ready) for i in range(args.clients))
+    )
+
+    summary = summarize(args, results)
+    print(json.dumps(summary, indent=2))
+
+    if args.save_baseline:
+        os.makedirs(os.path.dirname(os.path.abspath(args.save_baseline)), exist_ok=True)
+
+        with open(args.save_baseline, "w") as file:
+            json.dump(summary, file, indent=2)
+
+        print(f"Baseline written to {args.save_baseline}")
+
+    if args.baseline:
+        with open(args.baseline) as file:
+            regressions = compare(summary, json.load(file), args.tolerance)
+
+        for regression in regressions:
+            print(f"REGRESSION {regression}", file=sys.stderr)
+
+        return 1 if regressions else 0
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(asyncio.run(main()))
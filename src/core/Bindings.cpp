@@ -0,0 +1,10 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "Bindings.h"
+
+// Define empty Timer Wheel.
+std::vector<Bindings::Entry> Bindings::wheel[Bindings::SLOTS];
+size_t Bindings::cursor = 0;
+unsigned long Bindings::lastTick = 0;
@@ -0,0 +1,192 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef BINDINGS_H
+#define BINDINGS_H
+
+#include <map>
+#include <vector>
+#include <functional>
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "components/Component.h"
+
+/**
+ * @brief Central scheduler for components bound to a data source.
+ *
+ * Bindings are kept in a hashed timer wheel: each slot covers one tick, a binding due
+ * in more ticks than the wheel has slots waits for additional rounds. Advancing a tick
+ * only touches the bindings of a single slot, so the cost does not grow with the number
+ * of bindings which are not due.
+ *
+ * Getters are only sampled if at least one client views the page of the component,
+ * unchanged values are suppressed and all changes of a page are pushed in one packet.
+ */
+class Bindings
+{
+public:
+    static constexpr size_t SLOTS = 64;
+    static constexpr uint32_t TICK = 50; // Resolution of the wheel in milliseconds.
+
+private:
+    /**
+     * A bound component together with its data source.
+     */
+    struct Entry
+    {
+        Component* component;
+        std::function<String()> getter;
+        uint32_t interval;
+        uint32_t rounds;
+        String last;
+        bool sampled;
+    };
+
+    static std::vector<Entry> wheel[SLOTS];
+    static size_t cursor;
+    static unsigned long lastTick;
+
+    /**
+     * Inserts an entry into the slot which is reached after its interval.
+     */
+    static void insert(Entry&& entry)
+    {
+        const uint32_t ticks = entry.interval / TICK > 0 ? entry.interval / TICK : 1;
+
+        entry.rounds = (ticks - 1) / SLOTS;
+
+        wheel[(cursor + ticks) % SLOTS].push_back(std::move(entry));
+    }
+
+public:
+    /**
+     * @brief Binds a component to a getter, replacing an existing binding of the component.
+     *
+     * @param component The component receiving the sampled values through `setState`.
+     * @param getter The data source.
+     * @param interval The sampling interval in milliseconds.
+     */
+    static void add(Component* component, std::function<String()> getter, uint32_t interval)
+    {
+        remove(component);
+
+        insert(Entry{component, std::move(getter), interval, 0, String(), false});
+    }
+
+    /**
+     * @brief Removes the binding of a component.
+     *
+     * @param component The component to unbind.
+     */
+    static void remove(Component* component)
+    {
+        for (auto& slot : wheel)
+        {
+            for (size_t i = 0; i < slot.size(); i++)
+            {
+                if (slot[i].component == component)
+                {
+                    slot.erase(slot.begin() + i);
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Sends the current values of all bindings of a page again on their next sample.
+     *
+     * Called when an update of the page could not be delivered to one of its viewers,
+     * the unchanged value would be suppressed otherwise.
+     *
+     * @param page The page whose bindings are resent.
+     */
+    static void resync(Page* page)
+    {
+        for (auto& slot : wheel)
+        {
+            for (Entry& entry : slot)
+            {
+                if (entry.component->getPage() == page)
+                {
+                    entry.sampled = false;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Advances the wheel to the given time and samples all due bindings.
+     *
+     * @param now The current time in milliseconds.
+     * @param viewed Returns whether at least one client currently views the given page.
+     * @param push Receives the changed values of a page as {"componentId": "value", ...}.
+     */
+    static void tick(unsigned long now, const std::function<bool(Page*)>& viewed,
+                     const std::function<void(Page*, JsonDocument&)>& push)
+    {
+        std::map<Page*, JsonDocument> updates;
+
+        for (size_t ticks = 0; now - lastTick >= TICK; ticks++)
+        {
+            // Skip ahead instead of catching up a long Stall tick by tick.
+            if (ticks == SLOTS)
+            {
+                lastTick = now;
+                break;
+            }
+
+            lastTick += TICK;
+            cursor = (cursor + 1) % SLOTS;
+
+            std::vector<Entry> slot;
+            slot.swap(wheel[cursor]);
+
+            for (Entry& entry : slot)
+            {
+                if (entry.rounds > 0)
+                {
+                    entry.rounds--;
+                    wheel[cursor].push_back(std::move(entry));
+                    continue;
+                }
+
+                Page* page = entry.component->getPage();
+
+                // Without an Id the Browser cannot address the Component, wait until one is set.
+                // Nobody looks at the Page, do not even call the Getter.
+                if (page != nullptr && !entry.component->getId().isEmpty() && viewed(page))
+                {
+                    String value = entry.getter();
+
+                    if (!entry.sampled || value != entry.last)
+                    {
+                        // The Getter runs unlocked, it may block on a Sensor.
+                        std::lock_guard<std::recursive_mutex> guard(Component::stateLock);
+
+                        entry.component->setState(value);
+                        updates[page][entry.component->getId()] = value;
+
+                        entry.last = value;
+                        entry.sampled = true;
+                    }
+                }
+                else
+                {
+                    // Send the current Value again once somebody looks at the Page.
+                    entry.sampled = false;
+                }
+
+                insert(std::move(entry));
+            }
+        }
+
+        for (auto& update : updates)
+        {
+            push(update.first, update.second);
+        }
+    }
+};
+
+#endif
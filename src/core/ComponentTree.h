@@ -0,0 +1,185 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef COMPONENTTREE_H
+#define COMPONENTTREE_H
+
+#include <map>
+#include <vector>
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "components/Component.h"
+
+/**
+ * @brief Compact serialized form of a component tree, turned into DOM by framework.js.
+ *
+ * Every string (tags, ids, attributes, content) is stored once in a shared string table,
+ * nodes only reference it by index:
+ *
+ *   {"s":["","label","Hello","button","submit","Click me!"],"t":[[1,0,0,[],2],[3,4,0,[],5]]}
+ *
+ *   node: [tag, id, class, [attribute, value, ...], content]
+ *
+ * Index 0 is the empty string. The content is a string (inserted as HTML) or an array of
+ * child nodes. Trailing empty fields are omitted, e.g. [1] is an empty element.
+ */
+class ComponentTree
+{
+private:
+    JsonDocument strings;
+    std::map<String, uint16_t> lookup;
+    String nodes;
+    size_t count = 0;
+
+    /**
+     * Adds a string to the table unless it is stored already.
+     *
+     * @param value The string.
+     * @return The index of the string in the table.
+     */
+    uint16_t intern(const String& value)
+    {
+        if (value.isEmpty())
+        {
+            return 0;
+        }
+
+        auto it = lookup.find(value);
+
+        if (it != lookup.end())
+        {
+            return it->second;
+        }
+
+        const uint16_t index = strings.size();
+
+        strings.add(value);
+        lookup[value] = index;
+
+        return index;
+    }
+
+    /**
+     * Appends the node of a component and its children.
+     *
+     * @param c The component.
+     */
+    void append(Component* c)
+    {
+        Component::Node node;
+
+        c->describe(node);
+
+        const std::vector<Component*>& children = c->getChildren();
+        const uint16_t tag = intern(node.tag);
+        const uint16_t id = intern(node.id);
+        const uint16_t cssClass = intern(node.cssClass);
+
+        // Omit trailing empty Fields.
+        const size_t fields = !children.empty() || !node.content.isEmpty() ? 5
+                              : !node.attributes.empty() ? 4
+                              : cssClass != 0 ? 3
+                              : id != 0 ? 2
+                              : 1;
+
+        nodes += '[';
+        nodes += tag;
+
+        if (fields > 1)
+        {
+            nodes += ',';
+            nodes += id;
+        }
+
+        if (fields > 2)
+        {
+            nodes += ',';
+            nodes += cssClass;
+        }
+
+        if (fields > 3)
+        {
+            nodes += ",[";
+
+            for (size_t i = 0; i < node.attributes.size(); i++)
+            {
+                if (i > 0)
+                {
+                    nodes += ',';
+                }
+
+                nodes += intern(node.attributes[i].first);
+                nodes += ',';
+                nodes += intern(node.attributes[i].second);
+            }
+
+            nodes += ']';
+        }
+
+        if (fields > 4)
+        {
+            nodes += ',';
+
+            if (children.empty())
+            {
+                nodes += intern(node.content);
+            }
+            else
+            {
+                nodes += '[';
+
+                for (size_t i = 0; i < children.size(); i++)
+                {
+                    if (i > 0)
+                    {
+                        nodes += ',';
+                    }
+
+                    append(children[i]);
+                }
+
+                nodes += ']';
+            }
+        }
+
+        nodes += ']';
+    }
+
+public:
+    ComponentTree()
+    {
+        strings.add("");
+    }
+
+    /**
+     * @brief Adds a top level component together with its children.
+     *
+     * @param c The component to add.
+     */
+    void add(Component* c)
+    {
+        if (count++ > 0)
+        {
+            nodes += ',';
+        }
+
+        append(c);
+    }
+
+    /**
+     * @brief Serializes the string table and the nodes.
+     *
+     * @return The tree as JSON, e.g. {"s":[...],"t":[...]}.
+     */
+    String serialize() const
+    {
+        String table = "";
+
+        serializeJson(strings, table);
+
+        return "{\"s\":" + table + ",\"t\":[" + nodes + "]}";
+    }
+};
+
+#endif
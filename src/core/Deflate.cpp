@@ -0,0 +1,374 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "Deflate.h"
+
+#include <cstring>
+
+namespace
+{
+    // Base values and extra bits of the length codes 257..285.
+    const uint16_t LENGTH_BASE[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    const uint8_t LENGTH_EXTRA[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+
+    // Base values and extra bits of the distance codes 0..29.
+    const uint16_t DISTANCE_BASE[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+    };
+    const uint8_t DISTANCE_EXTRA[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    // CRC-32 lookup for half a byte, small enough to keep in flash.
+    const uint32_t CRC_TABLE[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+}
+
+Deflate::Deflate(Source source, Format format) : source(std::move(source)), format(format)
+{
+    checksum = format == ZLIB ? 1 : 0;
+
+    for (size_t i = 0; i < HASH_SIZE; i++)
+    {
+        head[i] = NONE;
+    }
+}
+
+size_t Deflate::read(uint8_t* out, size_t max)
+{
+    size_t written = 0;
+
+    while (written < max)
+    {
+        if (outputStart == outputEnd)
+        {
+            if (state == DONE)
+            {
+                break;
+            }
+
+            outputStart = 0;
+            outputEnd = 0;
+
+            // Encode until the Output Buffer could not take another Match.
+            while (state != DONE && outputEnd + 8 < sizeof(output))
+            {
+                step();
+            }
+        }
+
+        const size_t count = outputEnd - outputStart < max - written ? outputEnd - outputStart : max - written;
+
+        memcpy(out + written, output + outputStart, count);
+
+        outputStart += count;
+        written += count;
+    }
+
+    return written;
+}
+
+void Deflate::step()
+{
+    if (state == HEADER)
+    {
+        if (format == ZLIB)
+        {
+            // Announce the Window Size, the Check Bits make the Header a Multiple of 31.
+            uint8_t windowBits = 8;
+
+            while ((1u << windowBits) < WINDOW)
+            {
+                windowBits++;
+            }
+
+            const uint8_t cmf = ((windowBits - 8) << 4) | 8;
+
+            writeByte(cmf);
+            writeByte((31 - (cmf << 8) % 31) % 31);
+        }
+        else if (format == GZIP)
+        {
+            const uint8_t header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+
+            for (uint8_t value : header)
+            {
+                writeByte(value);
+            }
+        }
+
+        // A single final Block with fixed Huffman Codes.
+        writeBits(1, 1);
+        writeBits(1, 2);
+
+        state = DATA;
+    }
+    else if (state == DATA)
+    {
+        fill();
+
+        if (position == length)
+        {
+            writeSymbol(256);
+
+            // Pad the last Byte.
+            if (bitCount > 0)
+            {
+                writeBits(0, 8 - bitCount);
+            }
+
+            state = TRAILER;
+            return;
+        }
+
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+
+        if (length - position >= MIN_MATCH)
+        {
+            const size_t limit = length - position < MAX_MATCH ? length - position : MAX_MATCH;
+            uint16_t candidate = head[hashAt(position)];
+
+            for (size_t chain = 0; chain < MAX_CHAIN && candidate != NONE && position - candidate <= WINDOW; chain++)
+            {
+                size_t matchLength = 0;
+
+                while (matchLength < limit && buffer[candidate + matchLength] == buffer[position + matchLength])
+                {
+                    matchLength++;
+                }
+
+                if (matchLength > bestLength)
+                {
+                    bestLength = matchLength;
+                    bestDistance = position - candidate;
+
+                    if (matchLength == limit)
+                    {
+                        break;
+                    }
+                }
+
+                candidate = prev[candidate];
+            }
+        }
+
+        if (bestLength >= MIN_MATCH)
+        {
+            writeMatch(bestLength, bestDistance);
+
+            for (size_t i = 0; i < bestLength; i++)
+            {
+                insertHash(position++);
+            }
+        }
+        else
+        {
+            writeSymbol(buffer[position]);
+
+            insertHash(position++);
+        }
+    }
+    else if (state == TRAILER)
+    {
+        if (format == ZLIB)
+        {
+            for (int shift = 24; shift >= 0; shift -= 8)
+            {
+                writeByte(checksum >> shift);
+            }
+        }
+        else if (format == GZIP)
+        {
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                writeByte(checksum >> shift);
+            }
+
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                writeByte(total >> shift);
+            }
+        }
+
+        state = DONE;
+    }
+}
+
+void Deflate::fill()
+{
+    while (!sourceDone && length - position < MAX_MATCH)
+    {
+        if (length == BUFFER)
+        {
+            slide();
+        }
+
+        const size_t count = source(buffer + length, BUFFER - length);
+
+        if (count == 0)
+        {
+            sourceDone = true;
+            break;
+        }
+
+        if (format == ZLIB)
+        {
+            checksum = adler32(checksum, buffer + length, count);
+        }
+        else if (format == GZIP)
+        {
+            checksum = crc32(checksum, buffer + length, count);
+        }
+
+        length += count;
+        total += count;
+    }
+}
+
+void Deflate::slide()
+{
+    // The Lookahead is short, so at least WINDOW Bytes were encoded and can be dropped.
+    memmove(buffer, buffer + WINDOW, BUFFER - WINDOW);
+
+    position -= WINDOW;
+    length -= WINDOW;
+
+    for (size_t i = 0; i < HASH_SIZE; i++)
+    {
+        head[i] = head[i] != NONE && head[i] >= WINDOW ? head[i] - WINDOW : NONE;
+    }
+
+    for (size_t i = 0; i < BUFFER - WINDOW; i++)
+    {
+        const uint16_t link = prev[i + WINDOW];
+
+        prev[i] = link != NONE && link >= WINDOW ? link - WINDOW : NONE;
+    }
+}
+
+void Deflate::insertHash(size_t at)
+{
+    if (at + MIN_MATCH > length)
+    {
+        return;
+    }
+
+    const size_t hash = hashAt(at);
+
+    prev[at] = head[hash];
+    head[hash] = at;
+}
+
+void Deflate::writeBits(uint32_t value, uint8_t count)
+{
+    bits |= value << bitCount;
+    bitCount += count;
+
+    while (bitCount >= 8)
+    {
+        output[outputEnd++] = bits & 0xFF;
+        bits >>= 8;
+        bitCount -= 8;
+    }
+}
+
+void Deflate::writeCode(uint32_t code, uint8_t count)
+{
+    // Huffman Codes are packed starting with their most significant Bit.
+    uint32_t reversed = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+
+    writeBits(reversed, count);
+}
+
+void Deflate::writeSymbol(uint16_t symbol)
+{
+    if (symbol < 144)
+    {
+        writeCode(0x30 + symbol, 8);
+    }
+    else if (symbol < 256)
+    {
+        writeCode(0x190 + symbol - 144, 9);
+    }
+    else if (symbol < 280)
+    {
+        writeCode(symbol - 256, 7);
+    }
+    else
+    {
+        writeCode(0xC0 + symbol - 280, 8);
+    }
+}
+
+void Deflate::writeMatch(size_t matchLength, size_t distance)
+{
+    size_t code = 28;
+
+    while (LENGTH_BASE[code] > matchLength)
+    {
+        code--;
+    }
+
+    writeSymbol(257 + code);
+    writeBits(matchLength - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+
+    code = 29;
+
+    while (DISTANCE_BASE[code] > distance)
+    {
+        code--;
+    }
+
+    writeCode(code, 5);
+    writeBits(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+}
+
+void Deflate::writeByte(uint8_t value)
+{
+    writeBits(value, 8);
+}
+
+uint32_t Deflate::crc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+    crc = ~crc;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+    }
+
+    return ~crc;
+}
+
+uint32_t Deflate::adler32(uint32_t adler, const uint8_t* data, size_t size)
+{
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+
+    return (b << 16) | a;
+}
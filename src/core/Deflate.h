@@ -0,0 +1,154 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef DEFLATE_H
+#define DEFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief Streaming deflate encoder (RFC 1951) with raw, zlib (RFC 1950) and gzip (RFC 1952) framing.
+ *
+ * The encoder pulls its input from a source callback and hands out the compressed stream
+ * through `read`, so neither the input nor the output has to be kept in memory. It uses a
+ * small fixed window and the fixed Huffman codes of the format, which keeps the whole state
+ * at about 7 KB and needs no second pass over the data. HTML compresses well even so,
+ * repeated tags and attributes are found within the window.
+ *
+ * The state is large for a task stack, create encoders on the heap.
+ */
+class Deflate
+{
+public:
+    enum Format
+    {
+        RAW,
+        ZLIB,
+        GZIP
+    };
+
+    /**
+     * Fills the given buffer with up to `max` bytes of input and returns the number of bytes
+     * written, 0 marks the end of the input.
+     */
+    using Source = std::function<size_t(uint8_t* buffer, size_t max)>;
+
+    /**
+     * Largest distance of a match, must be a power of two of at most 32768.
+     */
+    static constexpr size_t WINDOW = 1024;
+
+private:
+    static constexpr size_t BUFFER = 2 * WINDOW;
+    static constexpr size_t MIN_MATCH = 3;
+    static constexpr size_t MAX_MATCH = 258;
+    static constexpr size_t HASH_SIZE = 512;
+    static constexpr size_t MAX_CHAIN = 8; // Candidates compared per position.
+    static constexpr uint16_t NONE = 0xFFFF;
+
+    enum State
+    {
+        HEADER,
+        DATA,
+        TRAILER,
+        DONE
+    };
+
+    Source source;
+    Format format;
+    State state = HEADER;
+
+    /**
+     * Sliding input buffer: up to WINDOW bytes of history followed by the lookahead.
+     */
+    uint8_t buffer[BUFFER];
+    size_t position = 0; // Next byte to encode.
+    size_t length = 0; // Bytes in the buffer.
+    bool sourceDone = false;
+
+    /**
+     * Hash chains of 3 byte sequences: head holds the latest position of each hash,
+     * prev links every position to the previous one with the same hash.
+     */
+    uint16_t head[HASH_SIZE];
+    uint16_t prev[BUFFER];
+
+    uint32_t checksum = 0;
+    uint32_t total = 0;
+
+    uint32_t bits = 0;
+    uint8_t bitCount = 0;
+
+    /**
+     * Encoded bytes not handed out by `read` yet.
+     */
+    uint8_t output[128];
+    size_t outputStart = 0;
+    size_t outputEnd = 0;
+
+    void fill();
+    void slide();
+    void step();
+    void insertHash(size_t at);
+
+    size_t hashAt(size_t at) const
+    {
+        return ((buffer[at] << 6) ^ (buffer[at + 1] << 3) ^ buffer[at + 2]) & (HASH_SIZE - 1);
+    }
+
+    void writeBits(uint32_t value, uint8_t count);
+    void writeCode(uint32_t code, uint8_t count);
+    void writeSymbol(uint16_t symbol);
+    void writeMatch(size_t matchLength, size_t distance);
+    void writeByte(uint8_t value);
+
+public:
+    /**
+     * @brief Creates an encoder reading from the given source.
+     *
+     * @param source Provides the uncompressed input.
+     * @param format The framing of the compressed stream.
+     */
+    explicit Deflate(Source source, Format format = GZIP);
+
+    /**
+     * @brief Reads the next part of the compressed stream.
+     *
+     * @param out The buffer receiving the compressed bytes.
+     * @param max The size of the buffer.
+     * @return The number of bytes written, 0 once the stream is complete.
+     */
+    size_t read(uint8_t* out, size_t max);
+
+    /**
+     * @brief Checks whether the complete stream was read.
+     *
+     * @return True if `read` will not return any more bytes.
+     */
+    bool finished() const { return state == DONE && outputStart == outputEnd; }
+
+    /**
+     * @brief Updates a CRC-32 (as used by gzip) with the given data.
+     *
+     * @param crc The CRC of the preceding data, 0 to start.
+     * @param data The data.
+     * @param size The number of bytes.
+     * @return The updated CRC.
+     */
+    static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Updates an Adler-32 checksum (as used by zlib) with the given data.
+     *
+     * @param adler The checksum of the preceding data, 1 to start.
+     * @param data The data.
+     * @param size The number of bytes.
+     * @return The updated checksum.
+     */
+    static uint32_t adler32(uint32_t adler, const uint8_t* data, size_t size);
+};
+
+#endif
@@ -6,8 +6,10 @@
 #define PAGE_H
 
 #include <vector>
+#include <memory>
 #include <Arduino.h>
 #include "components/Component.h"
+#include "ComponentTree.h"
 
 /**
  * @brief Represents a webpage with components and customizable content.
@@ -20,9 +22,45 @@ class Page
 {
 private:
     std::vector<Component*> components;
+
+    /**
+     * Open addressing table (linear probing) mapping component ids to components.
+     *
+     * Slots are keyed on the precomputed id hash of each component, the capacity is
+     * always a power of two and kept at most half full.
+     */
+    std::vector<Component*> index;
+    size_t indexSize = 0;
+
     String title = "ESP32 Webpage";
     String extraHead; // Platz für zusätzliches CSS/JS
 
+    /**
+     * Incremented on every change of the rendered output, used by clients to cache fragments.
+     */
+    uint32_t version = 1;
+
+    /**
+     * Indicates whether framework.js builds the DOM from the compact component tree
+     * instead of receiving rendered HTML.
+     */
+    bool clientRendered = false;
+
+    /**
+     * Incremented whenever components or listeners change, invalidates the precomputed packets.
+     */
+    uint32_t listenerVersion = 1;
+
+    /**
+     * Precomputed listener map and welcome packet, rebuilt lazily when listenerVersion changed.
+     *
+     * The welcome packet is a shared buffer, so all clients navigating to this page receive
+     * the same bytes without any serialization per client.
+     */
+    uint32_t packetVersion = 0;
+    String listenerJson;
+    std::shared_ptr<std::vector<uint8_t>> welcomePacket;
+
     /**
      * @brief Sets the title for the object.
      *
@@ -34,6 +72,76 @@ public:
     void setTitle(const String& t)
     {
         title = t;
+
+        touch();
+    }
+
+    /**
+     * @brief Retrieves the title of the page.
+     *
+     * @return The title shown in the browser tab.
+     */
+    String getTitle() const
+    {
+        return title;
+    }
+
+    /**
+     * @brief Marks the rendered output of the page as changed.
+     *
+     * Increments the page version so clients drop cached fragments of this page.
+     * Called automatically when the page or one of its components is modified.
+     */
+    void touch()
+    {
+        version++;
+    }
+
+    /**
+     * @brief Retrieves the current version of the rendered output.
+     *
+     * @return A counter which changes whenever the rendered output changes.
+     */
+    uint32_t getVersion() const
+    {
+        return version;
+    }
+
+    /**
+     * @brief Marks the listener map of the page as changed.
+     *
+     * The precomputed welcome packet is rebuilt on the next request. Called automatically
+     * when components are added or listeners and ids of components change.
+     */
+    void touchListeners()
+    {
+        listenerVersion++;
+    }
+
+    /**
+     * @brief Retrieves the serialized listener map of all components.
+     *
+     * Maps each component id to the list of its event types, e.g. {"button":["click"]}.
+     *
+     * @return The listener map as JSON, rebuilt only if listeners changed.
+     */
+    const String& getListenerJson()
+    {
+        rebuildPackets();
+
+        return listenerJson;
+    }
+
+    /**
+     * @brief Retrieves the precomputed welcome packet of the page.
+     *
+     * @return A shared buffer holding {"type":"welcome","value":{...}}, rebuilt only if listeners changed.
+     */
+    std::shared_ptr<std::vector<uint8_t>> getWelcomePacket()
+    {
+        rebuildPackets();
+
+        return welcomePacket;
     }
 
     /**
@@ -46,6 +154,8 @@ public:
     void addExtraHead(const String& headContent)
     {
         extraHead += headContent + "\n";
+
+        touch();
     }
 
     /**
@@ -61,32 +171,279 @@ public:
     {
         components.push_back(c);
 
+        attachComponent(c);
+
+        touch();
+
         return c;
     }
 
+    /**
+     * @brief Assigns a component and all of its children to this page and indexes their ids.
+     *
+     * Called by `addComponent` and by containers when a child is added to them later.
+     *
+     * @param c The component to attach.
+     */
+    void attachComponent(Component* c)
+    {
+        touchListeners();
+
+        c->setPage(this);
+
+        indexComponent(c);
+
+        for (Component* child : c->getChildren())
+        {
+            attachComponent(child);
+        }
+    }
+
     /**
      * @brief Retrieves a component by its unique identifier.
      *
-     * Searches through the list of components to find and return the component
-     * that matches the specified identifier. If no matching component is found,
+     * Looks up the component in the id index, only components with a matching
+     * id hash are compared by string. If no matching component is found,
      * it returns a null pointer.
      *
      * @param id The unique identifier of the component to search for.
      * @return A pointer to the component with the specified ID, or nullptr if no
      *         matching component is found.
      */
-    Component* getComponentById(const String& id)
+    Component* getComponentById(const String& id) const
+    {
+        if (index.empty())
+        {
+            return nullptr;
+        }
+
+        const uint32_t hash = Component::hashId(id);
+        const size_t mask = index.size() - 1;
+
+        for (size_t i = hash & mask; index[i] != nullptr; i = (i + 1) & mask)
+        {
+            if (index[i]->getIdHash() == hash && index[i]->getId() == id)
+            {
+                return index[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Adds a component to the id index.
+     *
+     * Components without an id are not indexed. If another component already uses
+     * the same id, a warning is printed and lookups keep returning the first one.
+     * Called by `addComponent` and `Component::setId`.
+     *
+     * @param c The component to index.
+     */
+    void indexComponent(Component* c)
+    {
+        if (c->getId().isEmpty())
+        {
+            return;
+        }
+
+        // Keep the table at most half full.
+        if ((indexSize + 1) * 2 > index.size())
+        {
+            rebuildIndex(index.empty() ? 16 : index.size() * 2);
+        }
+
+        insertIntoIndex(c);
+    }
+
+    /**
+     * @brief Removes a component from the id index.
+     *
+     * Uses backward shift deletion, so no tombstones are left behind. If a component
+     * with the same id was shadowed by the removed one, it takes over the slot.
+     * Must be called before the id of the component changes.
+     *
+     * @param c The component to remove.
+     */
+    void unindexComponent(Component* c)
+    {
+        if (index.empty() || c->getId().isEmpty())
+        {
+            return;
+        }
+
+        const size_t mask = index.size() - 1;
+        size_t i = c->getIdHash() & mask;
+
+        while (index[i] != c)
+        {
+            // Component was not indexed (duplicate id).
+            if (index[i] == nullptr)
+            {
+                return;
+            }
+
+            i = (i + 1) & mask;
+        }
+
+        index[i] = nullptr;
+        indexSize--;
+
+        // Shift following entries of the cluster back into the gap.
+        for (size_t j = (i + 1) & mask; index[j] != nullptr; j = (j + 1) & mask)
+        {
+            const size_t home = index[j]->getIdHash() & mask;
+
+            // Entry can move if its home slot is not within (i, j].
+            if (((j - home) & mask) >= ((j - i) & mask))
+            {
+                index[i] = index[j];
+                index[j] = nullptr;
+                i = j;
+            }
+        }
+
+        // Promote a component which was hidden behind the removed one.
+        Component* shadowed = findDuplicate(components, c);
+
+        if (shadowed != nullptr)
+        {
+            insertIntoIndex(shadowed);
+        }
+    }
+
+private:
+    /**
+     * @brief Collects the listeners of the given components and their children.
+     *
+     * @param list The components whose listeners should be collected.
+     * @param listeners The object receiving the component ids and their event types.
+     */
+    static void collectListeners(const std::vector<Component*>& list, JsonObject listeners)
     {
-        for (auto comp : components)
+        for (Component* c : list)
         {
-            if (comp->getId() == id)
+            // Check if Component has a Listener.
+            if (c->hasListeners() && !c->getId().isEmpty())
             {
-                return comp;
+                JsonArray events = listeners[c->getId()].to<JsonArray>();
+
+                for (const auto& listener : c->getListener())
+                {
+                    events.add(listener.first.c_str());
+                }
             }
+
+            // Components of Containers (e.g. Forms).
+            collectListeners(c->getChildren(), listeners);
         }
+    }
+
+    /**
+     * @brief Rebuilds the listener map and the welcome packet if listeners changed.
+     */
+    void rebuildPackets()
+    {
+        if (welcomePacket && packetVersion == listenerVersion)
+        {
+            return;
+        }
+
+        JsonDocument listeners;
+
+        collectListeners(components, listeners.to<JsonObject>());
+
+        listenerJson = "";
+        serializeJson(listeners, listenerJson);
+
+        const String packet = "{\"type\":\"welcome\",\"value\":" + listenerJson + "}";
+
+        welcomePacket = std::make_shared<std::vector<uint8_t>>(packet.c_str(), packet.c_str() + packet.length());
+        packetVersion = listenerVersion;
+    }
+
+    /**
+     * @brief Searches a component tree for another component with the same id.
+     *
+     * @param list The components to search, children are searched recursively.
+     * @param c The component whose id is searched.
+     * @return The first other component with the same id, or nullptr.
+     */
+    static Component* findDuplicate(const std::vector<Component*>& list, Component* c)
+    {
+        for (Component* other : list)
+        {
+            if (other != c && other->getIdHash() == c->getIdHash() && other->getId() == c->getId())
+            {
+                return other;
+            }
+
+            Component* child = findDuplicate(other->getChildren(), c);
+
+            if (child != nullptr)
+            {
+                return child;
+            }
+        }
+
         return nullptr;
     }
 
+    /**
+     * @brief Inserts a component into the id index without resizing it.
+     *
+     * @param c The component to insert.
+     */
+    void insertIntoIndex(Component* c)
+    {
+        const size_t mask = index.size() - 1;
+
+        for (size_t i = c->getIdHash() & mask;; i = (i + 1) & mask)
+        {
+            if (index[i] == nullptr)
+            {
+                index[i] = c;
+                indexSize++;
+                return;
+            }
+
+            if (index[i] == c)
+            {
+                return;
+            }
+
+            if (index[i]->getIdHash() == c->getIdHash() && index[i]->getId() == c->getId())
+            {
+                Serial.printf("[ByteFramework] Duplicate component id '%s', lookups return the first one.\n",
+                              c->getId().c_str());
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Reallocates the id index with the given capacity and reinserts all indexed components.
+     *
+     * @param capacity The new capacity, must be a power of two.
+     */
+    void rebuildIndex(size_t capacity)
+    {
+        std::vector<Component*> old;
+        old.swap(index);
+
+        index.assign(capacity, nullptr);
+        indexSize = 0;
+
+        for (Component* c : old)
+        {
+            if (c != nullptr)
+            {
+                insertIntoIndex(c);
+            }
+        }
+    }
+
+public:
     /**
      * @brief Generates the HTML content for the head section of a web page.
      *
@@ -112,12 +469,76 @@ public:
         return head;
     }
 
+    /**
+     * @brief Enables or disables client side rendering for this page.
+     *
+     * Client side rendered pages are sent as compact component tree (see `ComponentTree`)
+     * which framework.js turns into DOM, so the device never concatenates the HTML of the
+     * components and the response is smaller.
+     *
+     * @param enabled True to let the browser render the page.
+     */
+    void setClientRendered(bool enabled)
+    {
+        clientRendered = enabled;
+
+        touch();
+    }
+
+    /**
+     * @brief Checks whether the page is rendered by the browser.
+     *
+     * @return True if the page is sent as component tree.
+     */
+    bool isClientRendered() const
+    {
+        return clientRendered;
+    }
+
+    /**
+     * @brief Serializes all components as compact tree for client side rendering.
+     *
+     * @return The tree as JSON, see `ComponentTree`.
+     */
+    String renderTree()
+    {
+        ComponentTree tree;
+
+        for (Component* c : components)
+        {
+            tree.add(c);
+        }
+
+        return tree.serialize();
+    }
+
+    /**
+     * @brief Renders the HTML of all components without the surrounding document.
+     *
+     * This fragment is the content of the page root and is also sent over the
+     * WebSocket when the client navigates in SPA mode.
+     *
+     * @return A string containing the HTML of all components.
+     */
+    String renderBody()
+    {
+        String html = "";
+
+        for (Component* c : components)
+        {
+            html += c->toHTML() + "\n";
+        }
+
+        return html;
+    }
+
     /**
      * @brief Renders the HTML representation of the object.
      *
      * This method constructs and returns a complete HTML document
      * by combining the head section, generated by renderHead,
-     * and the body section which includes the HTML of all components.
+     * and the body section generated by renderBody, wrapped into the page root.
+     * Client side rendered pages embed the component tree instead of the body.
      *
      * @return A string containing the generated HTML document.
      */
@@ -125,11 +546,21 @@ public:
     {
         String html = "<!DOCTYPE html>\n<html>\n<head>\n";
         html += renderHead();
-        html += "</head>\n<body>\n";
+        html += "</head>\n<body>\n<div id=\"bf-root\">\n";
 
-        for (Component* c : components)
+        if (clientRendered)
         {
-            html += c->toHTML() + "\n";
+            String tree = renderTree();
+
+            // "<" only occurs inside of JSON Strings, escaping it keeps the Content from closing the Script.
+            tree.replace("<", "\\u003c");
+
+            html += "</div>\n<script type=\"application/json\" id=\"bf-tree\">" + tree + "</script>\n";
+        }
+        else
+        {
+            html += renderBody();
+            html += "</div>\n";
         }
 
         html += "</body>\n</html>\n";
@@ -139,12 +570,13 @@ public:
     /**
      * @brief Retrieves the list of components associated with this object.
      *
-     * This method returns a collection of components currently managed or owned
-     * by the object.
+     * This method returns a read-only view of the top level components currently managed
+     * or owned by the object, no copy of the list is made. Children of containers are
+     * available through `Component::getChildren`.
      *
-     * @return A vector containing pointers to the components.
+     * @return A reference to the vector containing pointers to the components.
      */
-    std::vector<Component*> getComponents()
+    const std::vector<Component*>& getComponents() const
     {
         return components;
     }
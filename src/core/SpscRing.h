@@ -0,0 +1,87 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <stddef.h>
+
+/**
+ * @brief Lock-free single producer / single consumer ring buffer.
+ *
+ * Exactly one task may call `push` and exactly one (other) task may call `pop`.
+ * Head and tail are only written by their owning side, so no locks are needed;
+ * acquire/release ordering makes the slot contents visible across cores.
+ *
+ * @tparam T The element type, usually a pointer.
+ * @tparam N The capacity, must be a power of two.
+ */
+template <typename T, size_t N>
+class SpscRing
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+private:
+    T slots[N];
+    std::atomic<size_t> head{0}; // Next slot to write, owned by the producer.
+    std::atomic<size_t> tail{0}; // Next slot to read, owned by the consumer.
+
+public:
+    /**
+     * @brief Appends an element, called by the producer only.
+     *
+     * @param item The element to append.
+     * @return False if the ring is full.
+     */
+    bool push(const T& item)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+
+        if (h - tail.load(std::memory_order_acquire) == N)
+        {
+            return false;
+        }
+
+        slots[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element, called by the consumer only.
+     *
+     * @param item Receives the removed element.
+     * @return False if the ring is empty.
+     */
+    bool pop(T& item)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+
+        if (t == head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief Retrieves the number of queued elements.
+     *
+     * The value is only a snapshot when read from another task.
+     *
+     * @return The number of elements in the ring.
+     */
+    size_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
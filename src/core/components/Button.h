@@ -15,7 +15,10 @@ public:
     Button(String label, String id = "", String cssClass = "")
       : Component("button", id, cssClass), label(label) {}
 
-    void setLabel(const String& newLabel) { label = newLabel; }
+    void setLabel(const String& newLabel) { label = newLabel; markDirty(); markStateChanged(); }
+
+    String getState() const override { return label; }
+    void setState(const String& state) override { setLabel(state); }
 
     String getContentHTML() override {
         return label;
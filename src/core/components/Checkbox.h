@@ -15,13 +15,26 @@ public:
     Checkbox(String id, bool checked = false, String cssClass = "")
       : Component("input", id, cssClass), checked(checked) {}
 
-    void setChecked(bool c) { checked = c; }
+    void setChecked(bool c) { checked = c; markDirty(); markStateChanged(); }
     bool isChecked() const { return checked; }
 
+    String getState() const override { return checked ? "1" : "0"; }
+    void setState(const String& state) override { setChecked(state == "1" || state == "true"); }
+
+    bool acceptsInput() const override { return true; }
+
     String getContentHTML() override {
         return "";
     }
 
+    void describe(Node& node) override {
+        node.tag = "input";
+        node.id = id;
+        node.cssClass = cssClass;
+        node.attributes.push_back({"type", "checkbox"});
+        if (checked) node.attributes.push_back({"checked", ""});
+    }
+
     String toHTML() override {
         String html = "<input type=\"checkbox\"";
         if (!id.isEmpty()) html += " id=\"" + id + "\"";
@@ -3,3 +3,73 @@
 //
 
 #include "Component.h"
+#include "../Page.h"
+#include "../Bindings.h"
+
+// Define shared Lock of all Component States.
+std::recursive_mutex Component::stateLock;
+
+Component::~Component()
+{
+    // Stop sampling the Data Source of a deleted Component.
+    if (bound)
+    {
+        Bindings::remove(this);
+    }
+}
+
+void Component::setId(const String& newId)
+{
+    // Remove old Key from Page Index.
+    if (page != nullptr)
+    {
+        page->unindexComponent(this);
+    }
+
+    id = newId;
+    idHash = hashId(newId);
+
+    // Insert new Key into Page Index.
+    if (page != nullptr)
+    {
+        page->indexComponent(this);
+    }
+
+    markDirty();
+    markListenersDirty();
+}
+
+void Component::markDirty()
+{
+    if (page != nullptr)
+    {
+        page->touch();
+    }
+}
+
+void Component::markListenersDirty()
+{
+    if (page != nullptr)
+    {
+        page->touchListeners();
+    }
+}
+
+void Component::setBinding(std::function<String()> getter, uint32_t interval)
+{
+    bound = getter != nullptr;
+
+    if (bound)
+    {
+        if (id.isEmpty())
+        {
+            Serial.println("[ByteFramework] Bound component has no id, it is not updated until setId() is called.");
+        }
+
+        Bindings::add(this, getter, interval);
+    }
+    else
+    {
+        Bindings::remove(this);
+    }
+}
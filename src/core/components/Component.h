@@ -7,8 +7,13 @@
 
 #include <Arduino.h>
 #include <map>
+#include <vector>
+#include <chrono>
+#include <mutex>
 #include <ArduinoJson.h>
 
+class Page;
+
 /**
  * @class Component
  * @brief Represents a generic HTML component with a tag, ID, and CSS class.
@@ -29,7 +34,35 @@ protected:
     String id;
     String cssClass;
     String tag;
-    std::map<String, std::function<void(JsonObject)>> listeners;
+    std::map<String, std::function<void(JsonObject, JsonObject)>> listeners;
+
+    /**
+     * Page this component was added to, used to keep the page's id index in sync.
+     */
+    Page* page = nullptr;
+
+    /**
+     * Precomputed hash of the current id, used as key of the page's id index.
+     */
+    uint32_t idHash = 0;
+
+    /**
+     * Incremented whenever the user visible state (e.g. the value of an input) changes.
+     */
+    uint32_t stateVersion = 0;
+
+    /**
+     * Indicates whether the component is bound to a data source, see `bind`.
+     */
+    bool bound = false;
+
+    /**
+     * @brief Marks the state of the component as changed.
+     *
+     * Derived classes call this from setters of their state, so the change is
+     * picked up by the StateService.
+     */
+    void markStateChanged() { stateVersion++; }
 
 public:
     /**
@@ -44,10 +77,72 @@ public:
      * @param cssClass The CSS class or classes for the component (default is an empty string).
      */
     Component(String tag = "div", String id = "", String cssClass = "")
-        : tag(tag), id(id), cssClass(cssClass)
+        : tag(tag), id(id), cssClass(cssClass), idHash(hashId(id))
     {
     }
 
+    /**
+     * @brief Computes the hash used to index components by their ID.
+     *
+     * Uses 32-bit FNV-1a, which is cheap enough to run on every lookup and
+     * spreads short ASCII ids well.
+     *
+     * @param id The ID to hash.
+     * @return The 32-bit hash of the given ID.
+     */
+    static uint32_t hashId(const String& id)
+    {
+        uint32_t hash = 2166136261u;
+
+        for (size_t i = 0; i < id.length(); i++)
+        {
+            hash ^= (uint8_t)id[i];
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    /**
+     * @brief Escapes text for HTML content or a quoted attribute value.
+     *
+     * Values entered by users (inputs, text areas) pass through here before they are
+     * rendered, so a submitted or restored value can never inject markup.
+     *
+     * @param text The raw text.
+     * @return The text with &, <, >, " and ' replaced by entities.
+     */
+    static String escapeHTML(const String& text)
+    {
+        String escaped;
+
+        escaped.reserve(text.length());
+
+        for (size_t i = 0; i < text.length(); i++)
+        {
+            switch (text[i])
+            {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '"': escaped += "&quot;"; break;
+            case '\'': escaped += "&#39;"; break;
+            default: escaped += text[i];
+            }
+        }
+
+        return escaped;
+    }
+
+    /**
+     * @brief Guards the state of all components and the caches of their pages.
+     *
+     * Listeners, renders, bindings and the StateService may run on different tasks
+     * (AsyncTCP, loop, pipeline worker). The framework holds this lock while it reads or
+     * changes components; sketch code changing components from its own task takes it too.
+     * It is recursive, so listeners may render or persist while holding it.
+     */
+    static std::recursive_mutex stateLock;
 
     /**
      * @brief Adds a listener for a specific event.
@@ -58,8 +153,29 @@ public:
      * @param callback The function to be executed when the event with the given `eventId` is triggered. It takes a `String` parameter representing event-specific data.
      */
     void addListener(const String& eventId, std::function<void(JsonObject)> callback)
+    {
+        listeners[eventId] = [callback](JsonObject data, JsonObject result)
+        {
+            callback(data);
+        };
+
+        markListenersDirty();
+    }
+
+    /**
+     * @brief Adds a listener for a specific event which returns a result to the client.
+     *
+     * The callback fills the result object, which is delivered to the client as the
+     * response to its request (matched by the request id of the packet).
+     *
+     * @param eventId A unique identifier representing the event to listen for.
+     * @param callback The function to be executed, it receives the event data and the result object to fill.
+     */
+    void addListener(const String& eventId, std::function<void(JsonObject, JsonObject)> callback)
     {
         listeners[eventId] = callback;
+
+        markListenersDirty();
     }
 
     /**
@@ -70,14 +186,15 @@ public:
      *
      * @param eventId The identifier of the event to trigger.
      * @param data The data to pass to the listener associated with the event.
+     * @param result The object receiving the result of the listener, may be null if no result is requested.
      */
-    void triggerEvent(const String& eventId, const JsonObject& data)
+    virtual void triggerEvent(const String& eventId, const JsonObject& data, JsonObject result = JsonObject())
     {
         auto it = listeners.find(eventId);
 
         if (it != listeners.end())
         {
-            it->second(data);
+            it->second(data, result);
         }
     }
 
@@ -85,10 +202,11 @@ public:
      * @brief Sets the ID of the component.
      *
      * This method updates the ID attribute of the component with the provided value.
+     * If the component belongs to a page, the page's id index is updated as well.
      *
      * @param newId The new ID to assign to the component.
      */
-    void setId(const String& newId) { id = newId; }
+    void setId(const String& newId);
 
     /**
      * @brief Sets the CSS class for the component.
@@ -97,7 +215,12 @@ public:
      *
      * @param newClass The new CSS class to assign to the component.
      */
-    void setClass(const String& newClass) { cssClass = newClass; }
+    void setClass(const String& newClass)
+    {
+        cssClass = newClass;
+
+        markDirty();
+    }
 
     /**
      * @brief Sets the tag name of the HTML component.
@@ -107,7 +230,12 @@ public:
      *
      * @param tag The string representing the HTML tag name to set.
      */
-    void setTag(const String& newTag) { tag = newTag; }
+    void setTag(const String& newTag)
+    {
+        tag = newTag;
+
+        markDirty();
+    }
 
     /**
      * @brief Retrieves the ID associated with this instance.
@@ -119,6 +247,96 @@ public:
      */
     String getId() const { return id; }
 
+    /**
+     * @brief Retrieves the precomputed hash of the component's ID.
+     *
+     * @return The hash of the current ID as returned by `hashId`.
+     */
+    uint32_t getIdHash() const { return idHash; }
+
+    /**
+     * @brief Assigns the page this component belongs to.
+     *
+     * Called by `Page::addComponent`, there is no need to call it manually.
+     *
+     * @param owner The page the component was added to.
+     */
+    void setPage(Page* owner) { page = owner; }
+
+    /**
+     * @brief Retrieves the page this component belongs to.
+     *
+     * @return A pointer to the owning page, or nullptr if the component was not added to a page yet.
+     */
+    Page* getPage() const { return page; }
+
+    /**
+     * @brief Retrieves the child components of a container component.
+     *
+     * Containers like `Form` override this, so pages can index and attach their children.
+     *
+     * @return A reference to the list of children, empty for regular components.
+     */
+    virtual const std::vector<Component*>& getChildren() const
+    {
+        static const std::vector<Component*> none;
+
+        return none;
+    }
+
+    /**
+     * @brief Marks the rendered output of the owning page as changed.
+     *
+     * Derived classes call this from setters which change their HTML, so clients
+     * know their cached copy of the page is outdated.
+     */
+    void markDirty();
+
+    /**
+     * @brief Marks the listener map of the owning page as changed.
+     *
+     * Called when listeners are added or the id changes, so the page rebuilds its
+     * precomputed welcome packet.
+     */
+    void markListenersDirty();
+
+    /**
+     * @brief Binds the state of the component to a data source.
+     *
+     * The getter is sampled every interval, but only while at least one client views the
+     * page of the component. Changed values are applied through `setState` and pushed to
+     * those clients, e.g. `label->bind([] { return readTemp(); }, 500);`. The component
+     * needs an id, bindings of components without one are not sampled until an id is set.
+     *
+     * @param getter Returns the current value, anything `String` can be constructed from.
+     * @param interval The sampling interval in milliseconds.
+     */
+    template <typename Getter>
+    void bind(Getter getter, uint32_t interval)
+    {
+        setBinding([getter]() { return String(getter()); }, interval);
+    }
+
+    /**
+     * @brief Binds the state of the component to a data source, e.g. `bind(getter, 500ms)`.
+     *
+     * @param getter Returns the current value, anything `String` can be constructed from.
+     * @param interval The sampling interval.
+     */
+    template <typename Getter>
+    void bind(Getter getter, std::chrono::milliseconds interval)
+    {
+        bind(getter, (uint32_t)interval.count());
+    }
+
+    /**
+     * @brief Registers the binding of the component with the central scheduler.
+     *
+     * @param getter The data source, nullptr removes the binding.
+     * @param interval The sampling interval in milliseconds.
+     */
+    void setBinding(std::function<String()> getter, uint32_t interval);
+
     /**
      * @brief Retrieves the CSS class associated with the component.
      *
@@ -138,6 +356,68 @@ public:
      */
     String getTag() const { return tag; }
 
+    /**
+     * @brief Indicates whether the component is a form field the browser may submit values for.
+     *
+     * Only such fields are set by a Form submit, other components (labels, buttons) keep
+     * their content. Fields override this and render their value escaped.
+     *
+     * @return True for input fields, false by default.
+     */
+    virtual bool acceptsInput() const { return false; }
+
+    /**
+     * @brief Retrieves the state of the component in serialized form.
+     *
+     * Components with a user editable state (value, checked, ...) override this
+     * together with `setState`, the default implementation has no state.
+     *
+     * @return The serialized state, an empty string if the component has no state.
+     */
+    virtual String getState() const { return ""; }
+
+    /**
+     * @brief Restores the state of the component from its serialized form.
+     *
+     * @param state A string previously returned by `getState`.
+     */
+    virtual void setState(const String& state) {}
+
+    /**
+     * @brief Retrieves the version of the component's state.
+     *
+     * @return A counter which changes whenever the state changes.
+     */
+    uint32_t getStateVersion() const { return stateVersion; }
+
+    /**
+     * Description of a component for client side rendered pages, see `describe`.
+     */
+    struct Node
+    {
+        String tag;
+        String id;
+        String cssClass;
+        std::vector<std::pair<String, String>> attributes;
+        String content; // Inner HTML, ignored if the component has children.
+    };
+
+    /**
+     * @brief Describes the component as node of the compact tree sent for client side rendered pages.
+     *
+     * The description has to match `toHTML`: components which override `toHTML` override this
+     * as well and add their attributes. Children returned by `getChildren` are added by the tree.
+     *
+     * @param node The node to fill.
+     */
+    virtual void describe(Node& node)
+    {
+        node.tag = tag;
+        node.id = id;
+        node.cssClass = cssClass;
+        node.content = getContentHTML();
+    }
+
     /**
      * @brief Generates the HTML content specific to the derived component.
      *
@@ -176,9 +456,7 @@ public:
      * Ensures proper cleanup of resources when a derived Component object is destroyed.
      * Allows for polymorphic deletion when dealing with base class pointers.
      */
-    virtual ~Component()
-    {
-    }
+    virtual ~Component();
 
     /**
      * @brief Checks if the component has any registered listeners.
@@ -196,14 +474,14 @@ public:
     /**
      * @brief Retrieves a map of listeners for handling JSON object actions.
      *
-     * This method returns a map containing keys as string identifiers and
-     * values as corresponding function callbacks. These callbacks handle
+     * This method returns a read-only reference to the map containing keys as string
+     * identifiers and values as corresponding function callbacks. These callbacks handle
      * actions represented by JSON objects.
      *
      * @return A map where keys are string identifiers and values are
-     *         std::function<void(JsonObject)> representing action handlers.
+     *         std::function<void(JsonObject, JsonObject)> representing action handlers.
      */
-    std::map<String, std::function<void(JsonObject)>> getListener()
+    const std::map<String, std::function<void(JsonObject, JsonObject)>>& getListener() const
     {
         return listeners;
     }
@@ -0,0 +1,21 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "Form.h"
+#include "../Page.h"
+
+Component* Form::addComponent(Component* c)
+{
+    children.push_back(c);
+
+    // Index the Field if the Form is already part of a Page.
+    if (page != nullptr)
+    {
+        page->attachComponent(c);
+    }
+
+    markDirty();
+
+    return c;
+}
@@ -0,0 +1,112 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef FORM_H
+#define FORM_H
+
+#include "Component.h"
+
+/**
+ * @brief Groups input components and submits all of their values in one packet.
+ *
+ * framework.js collects the values of all fields of the form on submit and sends them
+ * as a single `execute` packet. The values are bound into the child components in one
+ * pass before the submit listener of the form is called once.
+ *
+ * Example packet:
+ * {"type":"execute","ack":false,"value":{"route":"/","component":"settings","event":"submit",
+ *  "data":{"values":{"name":"ESP32","enabled":true}}}}
+ */
+class Form : public Component {
+private:
+    std::vector<Component*> children;
+    bool ack = true;
+
+    /**
+     * Applies the submitted values to the given components and their children.
+     */
+    static void bindValues(const std::vector<Component*>& list, const JsonObject& values)
+    {
+        for (Component* child : list)
+        {
+            JsonVariant value = values[child->getId()];
+
+            // Only Form Fields take submitted Values, Labels and Buttons render their State as HTML.
+            if (child->acceptsInput() && !child->getId().isEmpty() && !value.isNull())
+            {
+                child->setState(value.as<String>());
+            }
+
+            bindValues(child->getChildren(), values);
+        }
+    }
+
+public:
+    Form(String id, String cssClass = "")
+      : Component("form", id, cssClass)
+    {
+        // Forms are always submitted over the WebSocket, even without a listener.
+        addListener("submit", [](JsonObject data) {});
+    }
+
+    /**
+     * @brief Adds a field (or any other component) to the form.
+     *
+     * @param c The component to add.
+     * @return A pointer to the component that was added.
+     */
+    Component* addComponent(Component* c);
+
+    /**
+     * @brief Disables the acknowledgement the client receives after a submit.
+     *
+     * @param enabled False to let the client send fire-and-forget submits.
+     */
+    void setAck(bool enabled) { ack = enabled; markDirty(); }
+
+    const std::vector<Component*>& getChildren() const override {
+        return children;
+    }
+
+    void triggerEvent(const String& eventId, const JsonObject& data, JsonObject result = JsonObject()) override {
+        // Bind all Values first, so the Listener sees the submitted State.
+        if (eventId == "submit")
+        {
+            bindValues(children, data["values"]);
+        }
+
+        Component::triggerEvent(eventId, data, result);
+    }
+
+    String getContentHTML() override {
+        String html = "";
+
+        for (Component* c : children)
+        {
+            html += c->toHTML() + "\n";
+        }
+
+        return html;
+    }
+
+    void describe(Node& node) override {
+        node.tag = "form";
+        node.id = id;
+        node.cssClass = cssClass;
+        if (!ack) node.attributes.push_back({"data-ack", "false"});
+    }
+
+    String toHTML() override {
+        String html = "<form";
+        if (!id.isEmpty()) html += " id=\"" + id + "\"";
+        if (!cssClass.isEmpty()) html += " class=\"" + cssClass + "\"";
+        if (!ack) html += " data-ack=\"false\"";
+        html += ">\n";
+        html += getContentHTML();
+        html += "</form>";
+        return html;
+    }
+};
+
+#endif
@@ -17,22 +17,36 @@ public:
     Input(const String& id, const String& type = "text", const String& placeholder = "", const String& cssClass = "")
       : Component("input", id, cssClass), type(type), placeholder(placeholder) {}
 
-    void setValue(const String& val) { value = val; }
+    void setValue(const String& val) { value = val; markDirty(); markStateChanged(); }
     String getValue() const { return value; }
 
-    void setPlaceholder(const String& ph) { placeholder = ph; }
+    String getState() const override { return value; }
+    void setState(const String& state) override { setValue(state); }
+
+    void setPlaceholder(const String& ph) { placeholder = ph; markDirty(); }
+
+    bool acceptsInput() const override { return true; }
 
     String getContentHTML() override {
         return "";
     }
 
+    void describe(Node& node) override {
+        node.tag = "input";
+        node.id = id;
+        node.cssClass = cssClass;
+        node.attributes.push_back({"type", type});
+        if (!placeholder.isEmpty()) node.attributes.push_back({"placeholder", placeholder});
+        if (!value.isEmpty()) node.attributes.push_back({"value", value});
+    }
+
     String toHTML() override {
         String html = "<input";
-        html += " type=\"" + type + "\"";
+        html += " type=\"" + escapeHTML(type) + "\"";
         if (!id.isEmpty()) html += " id=\"" + id + "\"";
         if (!cssClass.isEmpty()) html += " class=\"" + cssClass + "\"";
-        if (!placeholder.isEmpty()) html += " placeholder=\"" + placeholder + "\"";
-        if (!value.isEmpty()) html += " value=\"" + value + "\"";
+        if (!placeholder.isEmpty()) html += " placeholder=\"" + escapeHTML(placeholder) + "\"";
+        if (!value.isEmpty()) html += " value=\"" + escapeHTML(value) + "\"";
         html += ">";
         return html;
     }
@@ -15,7 +15,10 @@ public:
     Label(String text, String id = "", String cssClass = "")
       : Component("p", id, cssClass), text(text) {}
 
-    void setText(const String& newText) { text = newText; }
+    void setText(const String& newText) { text = newText; markDirty(); markStateChanged(); }
+
+    String getState() const override { return text; }
+    void setState(const String& state) override { setText(state); }
 
     String getContentHTML() override {
         return text;
@@ -0,0 +1,5 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "Link.h"
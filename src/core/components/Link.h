@@ -0,0 +1,51 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef LINK_H
+#define LINK_H
+
+#include "Component.h"
+
+/**
+ * @brief Anchor pointing to another page.
+ *
+ * In SPA mode framework.js intercepts clicks on links to the same host and
+ * navigates over the WebSocket instead of loading a new document.
+ */
+class Link : public Component {
+private:
+    String text;
+    String href;
+
+public:
+    Link(String text, String href, String id = "", String cssClass = "")
+      : Component("a", id, cssClass), text(text), href(href) {}
+
+    void setText(const String& newText) { text = newText; markDirty(); }
+    void setHref(const String& newHref) { href = newHref; markDirty(); }
+
+    String getContentHTML() override {
+        return text;
+    }
+
+    void describe(Node& node) override {
+        node.tag = "a";
+        node.id = id;
+        node.cssClass = cssClass;
+        node.attributes.push_back({"href", href});
+        node.content = text;
+    }
+
+    String toHTML() override {
+        String html = "<a href=\"" + href + "\"";
+        if (!id.isEmpty()) html += " id=\"" + id + "\"";
+        if (!cssClass.isEmpty()) html += " class=\"" + cssClass + "\"";
+        html += ">";
+        html += text;
+        html += "</a>";
+        return html;
+    }
+};
+
+#endif
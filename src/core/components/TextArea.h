@@ -16,12 +16,26 @@ public:
     TextArea(String id, int rows = 4, int cols = 40, String cssClass = "")
       : Component("textarea", id, cssClass), rows(rows), cols(cols) {}
 
-    void setValue(const String& val) { value = val; }
+    void setValue(const String& val) { value = val; markDirty(); markStateChanged(); }
     String getValue() const { return value; }
 
+    String getState() const override { return value; }
+    void setState(const String& state) override { setValue(state); }
+
+    bool acceptsInput() const override { return true; }
+
     String getContentHTML() override {
-        String html = value;
-        return html;
+        return escapeHTML(value);
+    }
+
+    void describe(Node& node) override {
+        node.tag = "textarea";
+        node.id = id;
+        node.cssClass = cssClass;
+        node.attributes.push_back({"rows", String(rows)});
+        node.attributes.push_back({"cols", String(cols)});
+        // Content is applied with innerHTML by framework.js.
+        node.content = escapeHTML(value);
     }
 
     String toHTML() override {
@@ -30,7 +44,7 @@ public:
         if (!cssClass.isEmpty()) html += " class=\"" + cssClass + "\"";
         html += " rows=\"" + String(rows) + "\" cols=\"" + String(cols) + "\"";
         html += ">";
-        html += value;
+        html += escapeHTML(value);
         html += "</textarea>";
         return html;
     }
@@ -12,3 +12,47 @@ AsyncWebServer* PageService::server = nullptr;
 
 // Define default WebSocket Route.
 AsyncWebSocket PageService::socket = AsyncWebSocket("/ws");
+
+// Define default Navigation Mode.
+bool PageService::spa = false;
+
+// Define Client Heartbeat States.
+std::map<uint32_t, PageService::ClientState> PageService::clients = std::map<uint32_t, PageService::ClientState>();
+std::mutex PageService::clientsLock;
+
+// Define default Heartbeat Settings.
+uint32_t PageService::heartbeatInterval = 15000;
+uint32_t PageService::heartbeatTimeout = 10000;
+uint32_t PageService::idleTimeout = 0;
+unsigned long PageService::lastHeartbeat = 0;
+uint16_t PageService::maxClients = 8;
+
+// Define default Reconnect Settings.
+uint16_t PageService::maxReconnectAttempts = 5;
+uint32_t PageService::reconnectDelay = 3000;
+uint32_t PageService::reconnectMaxDelay = 30000;
+
+// Define empty Map of exported Pages.
+std::map<String, PageService::StaticPage> PageService::staticPages = std::map<String, PageService::StaticPage>();
+
+// Define Cache Validators of dynamic Pages.
+uint32_t PageService::bootId = 0;
+std::map<Page*, std::pair<uint32_t, time_t>> PageService::modified = std::map<Page*, std::pair<uint32_t, time_t>>();
+
+// Define default Admission Control Budgets, Renders and Heap are unlimited until setBudgets() is called.
+uint16_t PageService::renderBudget = 0;
+uint16_t PageService::clientQueueBudget = 8;
+uint32_t PageService::heapFloor = 0;
+uint32_t PageService::retryAfter = 2;
+std::atomic<uint16_t> PageService::activeRenders(0);
+std::atomic<uint32_t> PageService::rejectedRenders(0);
+std::atomic<uint32_t> PageService::shedFrames(0);
+
+// Define Pipeline Rings and Tasks (started by enablePipeline).
+SpscRing<PageService::InboundPacket*, 32> PageService::inbound;
+SpscRing<PageService::OutboundFrame*, 32> PageService::outbound;
+TaskHandle_t PageService::pipelineWorker = nullptr;
+TaskHandle_t PageService::pipelineSender = nullptr;
+
+// Define Config Packet Cache (built on first Connect).
+AsyncWebSocketSharedBuffer PageService::configPacket = nullptr;
@@ -6,10 +6,19 @@
 #define PAGEMANAGER_H
 
 #include <map>
+#include <set>
+#include <atomic>
+#include <ctime>
+#include <mutex>
+#include <utility>
+#include <vector>
 #include <Arduino.h>
 #include <SPIFFS.h>
 #include <ESPAsyncWebServer.h>
 #include <core/Page.h>
+#include <core/Deflate.h>
+#include <core/SpscRing.h>
+#include <core/Bindings.h>
 #include <ArduinoJson.h>
 
 class PageService
@@ -39,222 +48,1595 @@ private:
      */
     static AsyncWebSocket socket;
 
+    /**
+     * Indicates whether clients should navigate between pages over the WebSocket (SPA mode)
+     * instead of loading a new document for every route.
+     */
+    static bool spa;
+
+    /**
+     * Heartbeat bookkeeping of a single WebSocket client.
+     */
+    struct ClientState
+    {
+        unsigned long lastActivity = 0; // Last packet received from the client.
+        unsigned long pingSentAt = 0; // Time the outstanding ping was sent.
+        uint32_t rtt = 0; // Round trip time of the last answered ping in ms.
+        bool awaitingPong = false;
+        Page* page = nullptr; // Page the client navigated to last.
+    };
+
+    /**
+     * Heartbeat state of all connected clients, keyed by client id.
+     *
+     * Written from the AsyncTCP task (events) and the loop task (heartbeat), guarded by clientsLock.
+     */
+    static std::map<uint32_t, ClientState> clients;
+    static std::mutex clientsLock;
+
+    /**
+     * Heartbeat settings in milliseconds, see setHeartbeat() and setIdleTimeout().
+     */
+    static uint32_t heartbeatInterval;
+    static uint32_t heartbeatTimeout;
+    static uint32_t idleTimeout;
+    static unsigned long lastHeartbeat;
+
+    /**
+     * Maximum number of clients kept connected, the oldest ones are closed first.
+     */
+    static uint16_t maxClients;
+
+    /**
+     * Reconnect limits advertised to framework.js through the config packet.
+     */
+    static uint16_t maxReconnectAttempts;
+    static uint32_t reconnectDelay;
+    static uint32_t reconnectMaxDelay;
+
+    /**
+     * A page exported to the filesystem by addStaticPage(), served without a Page object in memory.
+     */
+    struct StaticPage
+    {
+        String file; // Path of the export without the .gz suffix.
+        String listenerJson; // Listener manifest, e.g. {"contact":["click"]}.
+        AsyncWebSocketSharedBuffer welcome;
+
+        /**
+         * Handlers registered with on(), keyed by component id and event.
+         */
+        std::map<String, std::map<String, std::function<void(JsonObject, JsonObject)>>> listeners;
+    };
+
+    /**
+     * Exported pages and handlers of exported pages, keyed by route.
+     */
+    static std::map<String, StaticPage> staticPages;
+
+    static constexpr const char* STATIC_DIR = "/bf";
+
+    /**
+     * Random value chosen at boot and part of every ETag and of the config packet, so
+     * caches never mix up the page versions of two boots (versions start at 1 again after a reboot).
+     */
+    static uint32_t bootId;
+
+    /**
+     * Version of each page together with the time it was first served in this version, used for Last-Modified.
+     */
+    static std::map<Page*, std::pair<uint32_t, time_t>> modified;
+
+    /**
+     * Pages smaller than this are sent uncompressed, the encoder would not pay off.
+     */
+    static constexpr size_t COMPRESS_MIN = 512;
+
+    /**
+     * Body of a compressed page response, streamed through the encoder while the response is sent.
+     *
+     * Holds the render slot of the response until the web server deletes the response.
+     */
+    struct CompressedBody
+    {
+        String html;
+        size_t offset = 0;
+        std::unique_ptr<Deflate> deflate;
+
+        ~CompressedBody()
+        {
+            releaseRender();
+        }
+    };
+
+    /**
+     * Admission control budgets, see setBudgets(). A budget of 0 is unlimited.
+     */
+    static uint16_t renderBudget;
+    static uint16_t clientQueueBudget;
+    static uint32_t heapFloor;
+    static uint32_t retryAfter;
+
+    /**
+     * Renders in progress and the work refused so far, reported by getUsage().
+     *
+     * Renders run in the AsyncTCP task, the pipeline worker and the loop task, hence atomic.
+     */
+    static std::atomic<uint16_t> activeRenders;
+    static std::atomic<uint32_t> rejectedRenders;
+    static std::atomic<uint32_t> shedFrames;
+
+    /**
+     * Decoded packet handed from the network task to the pipeline worker.
+     */
+    struct InboundPacket
+    {
+        uint32_t clientId;
+        JsonDocument doc;
+    };
+
+    /**
+     * Serialized frame handed from the pipeline worker back to the network core.
+     */
+    struct OutboundFrame
+    {
+        uint32_t clientId;
+        String payload;
+        AsyncWebSocketSharedBuffer shared; // Set instead of payload for precomputed packets.
+    };
+
+    /**
+     * Rings of the optional pipeline mode, see enablePipeline().
+     *
+     * inbound: AsyncTCP task (parse) -> worker task (dispatch, render, serialize).
+     * outbound: worker task -> sender task (hands frames to the socket).
+     */
+    static SpscRing<InboundPacket*, 32> inbound;
+    static SpscRing<OutboundFrame*, 32> outbound;
+    static TaskHandle_t pipelineWorker;
+    static TaskHandle_t pipelineSender;
+
+    /**
+     * Precomputed config packet shared by all clients, rebuilt when the settings change.
+     */
+    static AsyncWebSocketSharedBuffer configPacket;
+
+    /**
+     * Reserves one of the concurrent render slots.
+     *
+     * Rendering builds the whole page as String on the heap, so renders are refused while
+     * the render budget is exhausted or the free heap is below the floor. A granted slot
+     * must be returned with releaseRender().
+     *
+     * @return True if the render may start.
+     */
+    static bool acquireRender()
+    {
+        if (ESP.getFreeHeap() < heapFloor)
+        {
+            rejectedRenders++;
+            return false;
+        }
+
+        // Slots are always counted, so getUsage() reports them without a Budget as well.
+        if (++activeRenders > renderBudget && renderBudget > 0)
+        {
+            activeRenders--;
+            rejectedRenders++;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Returns a render slot granted by acquireRender().
+     */
+    static void releaseRender()
+    {
+        activeRenders--;
+    }
+
+    /**
+     * Decides whether a low priority frame (binding update, droppable eval) may be queued to a client.
+     *
+     * Such frames are shed while the queue of the client is over budget or the heap is below
+     * the floor, so a slow client misses intermediate updates instead of exhausting the heap.
+     *
+     * @param client The target WebSocket client.
+     * @return True if the frame may be queued.
+     */
+    static bool admitFrame(AsyncWebSocketClient* client)
+    {
+        if ((clientQueueBudget > 0 && client->queueLen() >= clientQueueBudget) || ESP.getFreeHeap() < heapFloor)
+        {
+            shedFrames++;
+            return false;
+        }
+
+        return true;
+    }
+
     /**
      * Sends a JSON-formatted message to an asynchronous WebSocket client.
      *
-     * Constructs a message with a status and a text message, and sends it to the specified client.
+     * Constructs a message with a status and a text message, and sends it to the specified client.
+     *
+     * @param clientId The id of the WebSocket client to which the message will be sent.
+     * @param error A flag indicating whether the message indicates an error (true) or success (false).
+     * @param str A null-terminated string containing the message content.
+     * @param id The request id of the packet this message answers, null if the client sent none.
+     * @param result The result of the listener which handled the request, omitted if empty.
+     */
+    static void sendMessage(uint32_t clientId, bool error, const char* str,
+                            JsonVariantConst id = JsonVariantConst(), JsonVariantConst result = JsonVariantConst())
+    {
+        JsonDocument value;
+
+        value["status"] = (error ? "error" : "success");
+        value["message"] = str;
+
+        if (result.size() > 0)
+        {
+            value["result"] = result;
+        }
+
+        sendPacket(clientId, "message", value, id);
+    }
+
+    /**
+     * Sends a packet to the specified WebSocket client with a given type and value.
+     *
+     * Constructs a JSON document containing the type and value, serializes it to a string,
+     * and sends the resulting string as a text message to the client.
+     *
+     * @param clientId The id of the target WebSocket client.
+     * @param type A string that specifies the type of the packet being sent.
+     * @param value A JsonObject that contains the value to be included in the packet.
+     * @param id The request id of the packet this packet answers, null if it is not a response.
+     */
+    static void sendPacket(uint32_t clientId, String type, JsonDocument value,
+                           JsonVariantConst id = JsonVariantConst())
+    {
+        JsonDocument doc;
+
+        doc["type"] = type;
+        doc["value"] = value;
+
+        // Correlate Response with the Request of the Client.
+        if (!id.isNull())
+        {
+            doc["id"] = id;
+        }
+
+        String result = "";
+
+        serializeJson(doc, result);
+
+        deliver(clientId, result);
+    }
+
+    /**
+     * Hands a serialized frame to the socket.
+     *
+     * Frames produced by the pipeline worker are queued to the sender task on the
+     * network core, all other frames are sent directly.
+     *
+     * @param clientId The id of the target WebSocket client.
+     * @param payload The serialized packet.
+     */
+    static void deliver(uint32_t clientId, const String& payload)
+    {
+        if (pipelineWorker != nullptr && xTaskGetCurrentTaskHandle() == pipelineWorker)
+        {
+            OutboundFrame* frame = new OutboundFrame{clientId, payload, nullptr};
+
+            if (outbound.push(frame))
+            {
+                xTaskNotifyGive(pipelineSender);
+                return;
+            }
+
+            // Sender is not keeping up, send from this Task instead of dropping the Frame.
+            delete frame;
+        }
+
+        socket.text(clientId, payload);
+    }
+
+    /**
+     * Hands a precomputed, reference counted packet to the socket without copying it.
+     *
+     * @param clientId The id of the target WebSocket client.
+     * @param buffer The serialized packet, shared with other clients.
+     */
+    static void deliver(uint32_t clientId, const AsyncWebSocketSharedBuffer& buffer)
+    {
+        if (pipelineWorker != nullptr && xTaskGetCurrentTaskHandle() == pipelineWorker)
+        {
+            OutboundFrame* frame = new OutboundFrame{clientId, String(), buffer};
+
+            if (outbound.push(frame))
+            {
+                xTaskNotifyGive(pipelineSender);
+                return;
+            }
+
+            delete frame;
+        }
+
+        AsyncWebSocketClient* client = socket.client(clientId);
+
+        if (client != nullptr)
+        {
+            client->text(buffer);
+        }
+    }
+
+    /**
+     * Sends the listener registration (welcome packet) of a page to the given client.
+     *
+     * @param clientId The id of the target WebSocket client.
+     * @param listenerJson The listener map of the page.
+     * @param welcome The precomputed welcome packet, shared by all clients.
+     * @param id The request id of the navigate packet, null if the client sent none.
+     */
+    static void sendWelcome(uint32_t clientId, const String& listenerJson, const AsyncWebSocketSharedBuffer& welcome,
+                            JsonVariantConst id)
+    {
+        if (id.isNull())
+        {
+            // Shared by all Clients, no Serialization per Client.
+            deliver(clientId, welcome);
+        }
+        else
+        {
+            String serializedId = "";
+
+            serializeJson(id, serializedId);
+
+            deliver(clientId, "{\"type\":\"welcome\",\"id\":" + serializedId + ",\"value\":" + listenerJson + "}");
+        }
+    }
+
+    /**
+     * Retrieves an exported page by its route.
+     *
+     * @param route The route of the page.
+     * @return The exported page, or nullptr if the route was not exported.
+     */
+    static StaticPage* getStaticPage(const String& route)
+    {
+        auto it = staticPages.find(route);
+
+        if (it != staticPages.end() && it->second.file.length() > 0)
+        {
+            return &it->second;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Renders a page built for the export and writes it gzip compressed to the filesystem,
+     * together with the manifest holding the version and the listeners of the page.
+     *
+     * @param route The route of the page.
+     * @param version The version of the page, stored in the manifest.
+     * @param page The page to export.
+     * @param entry The exported page receiving the listener manifest.
+     * @param manifestPath The path of the manifest file.
+     * @return True if both files were written.
+     */
+    static bool exportPage(const String& route, uint32_t version, Page* page, StaticPage& entry,
+                           const String& manifestPath)
+    {
+        const String html = page->render();
+        size_t offset = 0;
+
+        // Compress while writing, the compressed Page is never held in Memory.
+        std::unique_ptr<Deflate> deflate(new Deflate([&html, &offset](uint8_t* buffer, size_t max)
+        {
+            const size_t count = html.length() - offset < max ? html.length() - offset : max;
+
+            memcpy(buffer, html.c_str() + offset, count);
+            offset += count;
+
+            return count;
+        }, Deflate::GZIP));
+
+        File file = SPIFFS.open(entry.file + ".gz", FILE_WRITE);
+
+        if (!file)
+        {
+            return false;
+        }
+
+        uint8_t chunk[256];
+        size_t count;
+        bool written = true;
+
+        while (written && (count = deflate->read(chunk, sizeof(chunk))) > 0)
+        {
+            written = file.write(chunk, count) == count;
+        }
+
+        file.close();
+
+        // Listeners of the exported Page: Listeners of its Components and Handlers registered with on().
+        std::map<String, std::set<String>> events;
+
+        collectEvents(page->getComponents(), events);
+
+        for (auto& component : entry.listeners)
+        {
+            // A Handler of a missing Component is never triggered, checkHandlers() reports it.
+            if (page->getComponentById(component.first) == nullptr)
+            {
+                continue;
+            }
+
+            for (auto& event : component.second)
+            {
+                events[component.first].insert(event.first);
+            }
+        }
+
+        JsonDocument manifest;
+
+        manifest["route"] = route;
+        manifest["version"] = version;
+
+        JsonObject listeners = manifest["listeners"].to<JsonObject>();
+
+        for (auto& component : events)
+        {
+            JsonArray list = listeners[component.first].to<JsonArray>();
+
+            for (auto& event : component.second)
+            {
+                list.add(event);
+            }
+        }
+
+        file = SPIFFS.open(manifestPath, FILE_WRITE);
+
+        if (!written || !file || serializeJson(manifest, file) == 0)
+        {
+            if (file)
+            {
+                file.close();
+            }
+
+            // Never leave a Page behind which does not match its Manifest.
+            SPIFFS.remove(entry.file + ".gz");
+            SPIFFS.remove(manifestPath);
+
+            return false;
+        }
+
+        file.close();
+
+        return true;
+    }
+
+    /**
+     * Collects the events of the listeners of components and their children.
+     *
+     * @param list The components whose listeners should be collected.
+     * @param events Receives the events keyed by component id.
+     */
+    static void collectEvents(const std::vector<Component*>& list, std::map<String, std::set<String>>& events)
+    {
+        for (Component* c : list)
+        {
+            if (c->hasListeners() && !c->getId().isEmpty())
+            {
+                for (const auto& listener : c->getListener())
+                {
+                    events[c->getId()].insert(listener.first);
+                }
+            }
+
+            collectEvents(c->getChildren(), events);
+        }
+    }
+
+    /**
+     * Warns about events of an exported page which are sent without a handler and about
+     * handlers which are never triggered, so listeners lost with the exported components
+     * or a forgotten version increase do not fail silently.
+     *
+     * @param route The route of the exported page.
+     * @param entry The exported page with the handlers registered with on().
+     * @param listeners The listener manifest of the page.
+     */
+    static void checkHandlers(const String& route, const StaticPage& entry, JsonObject listeners)
+    {
+        for (JsonPair component : listeners)
+        {
+            const String id = component.key().c_str();
+            auto handlers = entry.listeners.find(id);
+
+            for (JsonVariant event : component.value().as<JsonArray>())
+            {
+                if (handlers == entry.listeners.end() || handlers->second.count(event.as<String>()) == 0)
+                {
+                    Serial.println("[ByteFramework] Event '" + id + "." + event.as<String>() + "' of exported page " +
+                                   route + " has no handler, register it with PageService::on() before addStaticPage().");
+                }
+            }
+        }
+
+        for (auto& component : entry.listeners)
+        {
+            JsonArray events = listeners[component.first];
+
+            for (auto& event : component.second)
+            {
+                bool found = false;
+
+                for (JsonVariant exported : events)
+                {
+                    found = found || exported.as<String>() == event.first;
+                }
+
+                if (!found)
+                {
+                    Serial.println("[ByteFramework] Handler '" + component.first + "." + event.first + "' of exported page " +
+                                   route + " is never triggered, check the component id or increase the version.");
+                }
+            }
+        }
+    }
+
+    /**
+     * Deletes components together with their children.
+     *
+     * @param list The components to delete.
+     */
+    static void releaseComponents(const std::vector<Component*>& list)
+    {
+        for (Component* c : list)
+        {
+            releaseComponents(c->getChildren());
+
+            delete c;
+        }
+    }
+
+    /**
+     * Checks whether the client accepts the given content coding.
+     *
+     * @param header The Accept-Encoding header of the request.
+     * @param coding The content coding, e.g. "gzip".
+     * @return True if the coding is listed without "q=0".
+     */
+    static bool acceptsEncoding(String header, const char* coding)
+    {
+        header.replace(" ", "");
+        header.toLowerCase();
+
+        const int start = header.indexOf(coding);
+
+        if (start < 0)
+        {
+            return false;
+        }
+
+        const String rest = header.substring(start + strlen(coding));
+
+        if (rest.startsWith(";q="))
+        {
+            return rest.substring(3).toFloat() > 0;
+        }
+
+        return true;
+    }
+
+    /**
+     * Formats the time the page was first served in its current version as HTTP date.
+     *
+     * @param page The page.
+     * @return The date, or an empty string if the clock was not set (e.g. no NTP).
+     */
+    static String lastModified(Page* page)
+    {
+        const time_t now = time(nullptr);
+
+        // Better no Last-Modified at all than one from 1970.
+        if (now < 1700000000)
+        {
+            return "";
+        }
+
+        auto& entry = modified[page];
+
+        if (entry.first != page->getVersion() || entry.second < 1700000000)
+        {
+            entry = {page->getVersion(), now};
+        }
+
+        struct tm moment;
+        char date[32];
+
+        gmtime_r(&entry.second, &moment);
+        strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S GMT", &moment);
+
+        return date;
+    }
+
+    /**
+     * Answers a request for a dynamic page.
+     *
+     * Requests carrying the current ETag (or Last-Modified date) are answered with 304 without
+     * rendering. Otherwise the page is rendered and, if the client accepts it, compressed with
+     * gzip or deflate while it is sent, using a small fixed window.
+     *
+     * @param request The request.
+     * @param page The requested page.
+     */
+    static void sendPage(AsyncWebServerRequest* request, Page* page)
+    {
+        char version[24];
+
+        // Listeners change the Page in other Tasks (Pipeline Worker, Bindings), the Lock is held
+        // from reading the Version until the Page is rendered, so the ETag matches the Content.
+        std::unique_lock<std::recursive_mutex> state(Component::stateLock);
+
+        snprintf(version, sizeof(version), "\"%08x-%u", (unsigned int)bootId, (unsigned int)page->getVersion());
+
+        // Every Representation has its own strong ETag, the Coding is appended to the Version.
+        const String accepted = request->header("Accept-Encoding");
+        const bool gzip = acceptsEncoding(accepted, "gzip");
+        const bool deflate = !gzip && acceptsEncoding(accepted, "deflate");
+        String etag = String(version) + (gzip ? "-gz\"" : deflate ? "-df\"" : "\"");
+
+        const String modifiedAt = lastModified(page);
+        bool notModified = false;
+
+        // If-None-Match takes Precedence, Browsers echo Last-Modified unchanged in If-Modified-Since.
+        if (request->hasHeader("If-None-Match"))
+        {
+            const String match = request->header("If-None-Match");
+
+            // Any Representation of the current Version is still valid, answer with the matched Tag.
+            for (const char* coding : {"\"", "-gz\"", "-df\""})
+            {
+                if (match.indexOf(String(version) + coding) >= 0)
+                {
+                    etag = String(version) + coding;
+                    notModified = true;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            notModified = modifiedAt.length() > 0 && request->header("If-Modified-Since") == modifiedAt;
+        }
+
+        AsyncWebServerResponse* response;
+
+        if (notModified)
+        {
+            state.unlock();
+
+            // The Client's Copy is current, nothing to render.
+            response = request->beginResponse(304);
+        }
+        else
+        {
+            // Refuse the Request instead of failing the Allocation while rendering.
+            if (!acquireRender())
+            {
+                response = request->beginResponse(503, "text/plain", "Server busy");
+
+                response->addHeader("Retry-After", String(retryAfter));
+                request->send(response);
+                return;
+            }
+
+            String html = page->render();
+
+            state.unlock();
+
+            if (html.length() >= COMPRESS_MIN && (gzip || deflate))
+            {
+                // Compress while sending, the compressed Page is never held in Memory.
+                std::shared_ptr<CompressedBody> body = std::make_shared<CompressedBody>();
+                CompressedBody* source = body.get();
+
+                body->html = std::move(html);
+                body->deflate.reset(new Deflate([source](uint8_t* buffer, size_t max)
+                {
+                    const size_t count = source->html.length() - source->offset < max
+                                             ? source->html.length() - source->offset
+                                             : max;
+
+                    memcpy(buffer, source->html.c_str() + source->offset, count);
+                    source->offset += count;
+
+                    return count;
+                }, gzip ? Deflate::GZIP : Deflate::ZLIB));
+
+                response = request->beginChunkedResponse("text/html", [body](uint8_t* buffer, size_t max, size_t index)
+                {
+                    return body->deflate->read(buffer, max);
+                });
+
+                response->addHeader("Content-Encoding", gzip ? "gzip" : "deflate");
+            }
+            else
+            {
+                // Prepare custom response.
+                response = request->beginResponse(200, "text/html", html);
+                etag = String(version) + "\"";
+
+                releaseRender();
+            }
+
+            // Add Framework Header.
+            response->addHeader("X-Framework", "ByteFramework");
+        }
+
+        // Browsers revalidate on every Visit, unchanged Pages only cost a 304.
+        response->addHeader("ETag", etag);
+        response->addHeader("Cache-Control", "no-cache");
+        response->addHeader("Vary", "Accept-Encoding");
+
+        if (modifiedAt.length() > 0)
+        {
+            response->addHeader("Last-Modified", modifiedAt);
+        }
+
+        // Send response to a client.
+        request->send(response);
+    }
+
+    /**
+     * Sends the configuration packet understood by framework.js to the given client.
+     *
+     * @param clientId The id of the WebSocket client which just connected.
+     */
+    static void sendConfig(uint32_t clientId)
+    {
+        if (!configPacket)
+        {
+            JsonDocument doc;
+
+            doc["type"] = "config";
+            doc["value"]["spa"] = spa;
+            doc["value"]["boot"] = bootId;
+            doc["value"]["maxReconnectAttempts"] = maxReconnectAttempts;
+            doc["value"]["reconnectDelay"] = reconnectDelay;
+            doc["value"]["reconnectMaxDelay"] = reconnectMaxDelay;
+
+            String packet = "";
+
+            serializeJson(doc, packet);
+
+            configPacket = std::make_shared<std::vector<uint8_t>>(packet.c_str(), packet.c_str() + packet.length());
+        }
+
+        deliver(clientId, configPacket);
+    }
+
+    /**
+     * Collects runtime statistics (heap and clients), used by load tests to track resource usage.
+     *
+     * @param stats The document receiving the statistics.
+     */
+    static void collectStats(JsonDocument& stats)
+    {
+        stats["uptime"] = millis();
+        stats["freeHeap"] = ESP.getFreeHeap();
+        stats["minFreeHeap"] = ESP.getMinFreeHeap();
+        stats["maxAllocHeap"] = ESP.getMaxAllocHeap();
+        stats["heapSize"] = ESP.getHeapSize();
+        stats["clients"] = socket.count();
+
+        const Usage usage = getUsage();
+
+        stats["renders"] = usage.renders;
+        stats["rejectedRenders"] = usage.rejectedRenders;
+        stats["maxClientQueue"] = usage.maxClientQueue;
+        stats["shedFrames"] = usage.shedFrames;
+    }
+
+    /**
+     * Handles WebSocket events by processing incoming messages, extracting information,
+     * and triggering corresponding events within the application.
+     *
+     * This method is intended to process specific types of WebSocket events, such as
+     * incoming text messages, and handle them accordingly by parsing JSON content and
+     * executing associated logic.
+     *
+     * @param server A pointer to the AsyncWebSocket instance managing the WebSocket server.
+     * @param client A pointer to the AsyncWebSocketClient instance representing the connected client.
+     * @param type The type of WebSocket event being triggered (e.g., WS_EVT_DATA).
+     * @param arg A void pointer to additional arguments associated with the event (e.g., frame details).
+     * @param data A pointer to the data payload received in the WebSocket message.
+     * @param len The length of the data payload in bytes.
+     */
+    static void onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
+                                 AwsEventType type, void* arg, uint8_t* data, size_t len)
+    {
+        if (type == WS_EVT_CONNECT)
+        {
+            {
+                std::lock_guard<std::mutex> lock(clientsLock);
+
+                clients[client->id()].lastActivity = millis();
+            }
+
+            sendConfig(client->id());
+        }
+        else if (type == WS_EVT_DISCONNECT)
+        {
+            std::lock_guard<std::mutex> lock(clientsLock);
+
+            clients.erase(client->id());
+        }
+        else if (type == WS_EVT_PONG)
+        {
+            std::lock_guard<std::mutex> lock(clientsLock);
+
+            auto it = clients.find(client->id());
+
+            if (it != clients.end() && it->second.awaitingPong)
+            {
+                it->second.rtt = millis() - it->second.pingSentAt;
+                it->second.awaitingPong = false;
+            }
+        }
+        else if (type == WS_EVT_DATA)
+        {
+            {
+                std::lock_guard<std::mutex> lock(clientsLock);
+
+                auto it = clients.find(client->id());
+
+                if (it != clients.end())
+                {
+                    it->second.lastActivity = millis();
+                }
+            }
+
+            AwsFrameInfo* info = (AwsFrameInfo*)arg;
+
+            if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT)
+            {
+                // ArduinoJson 7 or so allow dynamic deserialization.
+                JsonDocument doc;
+
+                // Try to deserialize JSON Packet (directly from the Frame Buffer).
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
+
+                if (error)
+                {
+                    Serial.print(F("deserializeJson() failed: "));
+                    Serial.println(error.f_str());
+                    client->text("{\"error\":\"Invalid JSON\"}");
+                    return;
+                }
+
+                // Hand the Packet to the Worker on the App Core in Pipeline Mode.
+                if (pipelineWorker != nullptr)
+                {
+                    InboundPacket* packet = new InboundPacket{client->id(), std::move(doc)};
+
+                    if (inbound.push(packet))
+                    {
+                        xTaskNotifyGive(pipelineWorker);
+                    }
+                    else
+                    {
+                        sendMessage(client->id(), true, "Server busy", packet->doc["id"]);
+
+                        delete packet;
+                    }
+
+                    return;
+                }
+
+                handlePacket(client->id(), doc);
+            }
+        }
+    }
+
+    /**
+     * Pipeline worker, pinned to the app core. Dispatches decoded packets, renders and
+     * serializes the responses, which are handed back through the outbound ring.
+     */
+    static void pipelineWorkerTask(void* parameter)
+    {
+        for (;;)
+        {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+
+            InboundPacket* packet;
+
+            while (inbound.pop(packet))
+            {
+                handlePacket(packet->clientId, packet->doc);
+
+                delete packet;
+            }
+        }
+    }
+
+    /**
+     * Pipeline sender, pinned to the network core. Hands serialized frames of the worker to the socket.
+     */
+    static void pipelineSenderTask(void* parameter)
+    {
+        for (;;)
+        {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+
+            OutboundFrame* frame;
+
+            while (outbound.pop(frame))
+            {
+                if (frame->shared)
+                {
+                    deliver(frame->clientId, frame->shared);
+                }
+                else
+                {
+                    socket.text(frame->clientId, frame->payload);
+                }
+
+                delete frame;
+            }
+        }
+    }
+
+    /**
+     * Dispatches a decoded packet of a client (navigate, execute, ...) and sends the responses.
+     *
+     * Runs in the AsyncTCP task, or in the pipeline worker if the pipeline mode is enabled.
+     *
+     * @param clientId The id of the WebSocket client which sent the packet.
+     * @param doc The decoded packet.
+     */
+    static void handlePacket(uint32_t clientId, JsonDocument& doc)
+    {
+        const String type = String(doc["type"]);
+        const JsonObject value = doc["value"];
+
+        // Optional Request ID, echoed in the Response to allow Pipelining.
+        const JsonVariantConst requestId = doc["id"];
+
+        // Clients may opt out of Success Responses (Fire and Forget), Errors are always sent.
+        const bool ack = doc["ack"] | true;
+
+        // Example:
+        // - Client: {"type":"navigate","value":{"route":"/"}}
+        // - Server: {"type":"message","value":{"status":"error","message":"Page not found"}}
+        //
+        // SPA Example:
+        // - Client: {"type":"navigate","value":{"route":"/","fragment":true,"version":3}}
+        // - Server: {"type":"page","value":{"route":"/","found":true,"version":3,"title":"...","listeners":{...}}}
+        // - Server: {"type":"page","value":{...,"tree":{"s":["","label","Hello"],"t":[[1,0,0,[],2]]}}} (client rendered)
+        if (type.equalsIgnoreCase("navigate"))
+        {
+            const String route = String(value["route"]);
+            const bool fragment = spa && (value["fragment"] | false);
+
+            // page => /
+            // listeners => componentId
+            //              - click
+            //              - change
+
+
+            // Get Page by Route.
+            auto page = getPageById(route);
+
+            // Remember the Page, Bindings are only sampled for Pages somebody looks at.
+            {
+                std::lock_guard<std::mutex> lock(clientsLock);
+
+                auto it = clients.find(clientId);
+
+                if (it != clients.end())
+                {
+                    it->second.page = page;
+                }
+            }
+
+            if (fragment)
+            {
+                JsonDocument response;
+
+                response["route"] = route;
+
+                // Exported Pages have no Fragment, the Client loads them as a Document instead.
+                response["found"] = page != nullptr;
+
+                if (page != nullptr)
+                {
+                    // Listeners change Components in the Worker Task, read a consistent Snapshot.
+                    std::lock_guard<std::recursive_mutex> guard(Component::stateLock);
+
+                    response["version"] = page->getVersion();
+                    response["title"] = page->getTitle();
+
+                    // Only send the Body if the cached Copy of the Client is outdated.
+                    if ((value["version"] | 0u) != page->getVersion())
+                    {
+                        if (acquireRender())
+                        {
+                            // Client rendered Pages are sent as Component Tree, the Browser builds the DOM.
+                            if (page->isClientRendered())
+                            {
+                                response["tree"] = serialized(page->renderTree());
+                            }
+                            else
+                            {
+                                response["body"] = page->renderBody();
+                            }
+
+                            releaseRender();
+                        }
+                        else
+                        {
+                            // Over Budget, the Client keeps its cached Copy and tries again later.
+                            response["retryAfter"] = retryAfter;
+                        }
+                    }
+
+                    // Precomputed Listener Map, embedded without parsing it again.
+                    response["listeners"] = serialized(page->getListenerJson());
+                }
+
+                // Send Page Packet (Fragment and Listener Registration in one Packet).
+                sendPacket(clientId, "page", response, requestId);
+            }
+            else if (page != nullptr)
+            {
+                String listenerJson;
+                AsyncWebSocketSharedBuffer welcome;
+
+                // The Listener Map is rebuilt lazily, Listeners may add Listeners meanwhile.
+                {
+                    std::lock_guard<std::recursive_mutex> guard(Component::stateLock);
+
+                    listenerJson = page->getListenerJson();
+                    welcome = page->getWelcomePacket();
+                }
+
+                // Send Welcome Packet (Listener Registration Packet).
+                sendWelcome(clientId, listenerJson, welcome, requestId);
+            }
+            else if (StaticPage* exported = getStaticPage(route))
+            {
+                // Exported Page, the Listeners come from its Manifest.
+                sendWelcome(clientId, exported->listenerJson, exported->welcome, requestId);
+            }
+            else
+            {
+                // Send response to client.
+                sendMessage(clientId, true, "Page not found", requestId);
+            }
+        }
+        // Example:
+        // - Client: {"type": "execute", "value": {"route": "/", "component": "test123","event": "click", "data": "xyz" }}
+        // - Client: {"type": "execute", "ack": false, "value": {...}} (no "Event processed" response)
+        // - Client: {"type": "execute", "id": 7, "value": {...}}
+        // - Server: {"type": "message", "id": 7, "value": {"status": "success", "message": "Event processed", "result": {...}}}
+        else if (type.equalsIgnoreCase("execute"))
+        {
+            const char* eventId = value["event"];
+            const JsonObject eventData = value["data"];
+
+            if (eventId != nullptr)
+            {
+                // Try to get page by id.
+                auto page = getPageById(String(value["route"]));
+
+                if (page != nullptr)
+                {
+                    // Try to get component by id.
+                    auto component = page->getComponentById(String(value["component"]));
+
+                    if (component != nullptr)
+                    {
+                        JsonDocument result;
+
+                        // Trigger the right listener of the component on the right page.
+                        {
+                            std::lock_guard<std::recursive_mutex> guard(Component::stateLock);
+
+                            component->triggerEvent(eventId, eventData, result.to<JsonObject>());
+                        }
+
+                        // Send response to client (unless the Client opted out).
+                        if (ack)
+                        {
+                            sendMessage(clientId, false, "Event processed", requestId, result);
+                        }
+                    }
+                    else
+                    {
+                        // Send response to client.
+                        sendMessage(clientId, true, "Component not found", requestId);
+                    }
+                }
+                else if (StaticPage* exported = getStaticPage(String(value["route"])))
+                {
+                    // Exported Pages have no Components, their Handlers were registered with on().
+                    auto component = exported->listeners.find(String(value["component"]));
+
+                    if (component != exported->listeners.end())
+                    {
+                        JsonDocument result;
+                        auto listener = component->second.find(eventId);
+
+                        if (listener != component->second.end())
+                        {
+                            std::lock_guard<std::recursive_mutex> guard(Component::stateLock);
+
+                            listener->second(eventData, result.to<JsonObject>());
+                        }
+
+                        // Send response to client (unless the Client opted out).
+                        if (ack)
+                        {
+                            sendMessage(clientId, false, "Event processed", requestId, result);
+                        }
+                    }
+                    else
+                    {
+                        // Send response to client.
+                        sendMessage(clientId, true, "Component not found", requestId);
+                    }
+                }
+                else
+                {
+                    // Send response to client.
+                    sendMessage(clientId, true, "Page not found", requestId);
+                }
+            }
+            else
+            {
+                // Send response to client.
+                sendMessage(clientId, true, "No event specified", requestId);
+            }
+        }
+        // Example:
+        // - Client: {"type":"stats","id":3}
+        // - Server: {"type":"stats","id":3,"value":{"freeHeap":123456,"minFreeHeap":100000,...}}
+        else if (type.equalsIgnoreCase("stats"))
+        {
+            JsonDocument stats;
+
+            collectStats(stats);
+
+            sendPacket(clientId, "stats", stats, requestId);
+        }
+        // Example:
+        // - Client: {"type":"pong","value":{}}
+        else if (type.equalsIgnoreCase("pong"))
+        {
+            // Nothing to do, activity was already recorded.
+        }
+        else
+        {
+            sendMessage(clientId, true, ("Unknown event type: " + type).c_str(), requestId);
+        }
+    }
+
+public:
+    /**
+     * Initializes and assigns the provided AsyncWebServer instance to the internal server.
+     *
+     * Add WebSocket Channel for Backend Communication on Route /ws.
+     *
+     * @param srv A pointer to the AsyncWebServer instance to be used by the system.
+     */
+    static void begin(AsyncWebServer* srv)
+    {
+        if (!SPIFFS.begin(true))
+        {
+            Serial.println("Fehler beim Mounten von SPIFFS");
+            return;
+        }
+
+        server = srv;
+
+        // Distinguish the Page Versions of this Boot from earlier ones in ETags.
+        bootId = esp_random();
+
+        // Register Channel Listener.
+        socket.onEvent(onWebSocketEvent);
+
+        // Service Static Files, except the private Files of the Framework (State, Exports) in /bf/.
+        server->serveStatic("/static", SPIFFS, "/").setFilter([](AsyncWebServerRequest* request)
+        {
+            return request->url().indexOf("/bf/") < 0;
+        });
+
+        // Add WebSocket to AsyncServer.
+        server->addHandler(&socket);
+    }
+
+    /**
+     * Enables or disables SPA mode.
+     *
+     * In SPA mode framework.js loads the first page as a normal document and then
+     * navigates between pages over the existing WebSocket, receiving the rendered
+     * body and the listeners of the target page in a single packet.
+     *
+     * @param enabled True to let clients navigate over the WebSocket.
+     */
+    static void setSpa(bool enabled)
+    {
+        spa = enabled;
+        configPacket.reset();
+    }
+
+    /**
+     * Enables the pipeline mode, which spreads the packet processing over both cores.
+     *
+     * Incoming packets are still parsed in the AsyncTCP task on the network core and then
+     * handed through a lock-free ring to a worker pinned to the app core, which dispatches
+     * listeners and renders and serializes the responses. The serialized frames travel
+     * through a second ring back to a sender task on the network core. Listeners then run
+     * in the worker task instead of the AsyncTCP task, while HTTP page requests are still
+     * rendered in the AsyncTCP task. Both hold Component::stateLock, code changing
+     * components from other tasks has to take it as well.
      *
-     * @param client The WebSocket client to which the message will be sent.
-     * @param error A flag indicating whether the message indicates an error (true) or success (false).
-     * @param str A null-terminated string containing the message content.
+     * Since every listener and every render runs under this one global lock, only the
+     * parsing of the next packets overlaps with the dispatch. Measure the gain with
+     * scripts/loadtest.py --outstanding before enabling it, on a single core it is slower.
+     *
+     * Must be called once after begin(), the mode cannot be disabled again.
+     *
+     * @param stackSize Stack size of the worker task in bytes, listeners run on this stack.
+     * @return True if both tasks were started.
      */
-    static void sendMessage(AsyncWebSocketClient* client, bool error, const char* str)
+    static bool enablePipeline(uint32_t stackSize = 8192)
     {
-        JsonDocument value;
+        if (pipelineWorker != nullptr)
+        {
+            return true;
+        }
 
-        value["status"] = (error ? "error" : "success");
-        value["message"] = str;
+        if (xTaskCreatePinnedToCore(pipelineSenderTask, "bf-sender", 4096, nullptr, 2, &pipelineSender,
+                                    PRO_CPU_NUM) != pdPASS)
+        {
+            Serial.println("[ByteFramework] Unable to start pipeline sender");
+            return false;
+        }
+
+        if (xTaskCreatePinnedToCore(pipelineWorkerTask, "bf-worker", stackSize, nullptr, 1, &pipelineWorker,
+                                    APP_CPU_NUM) != pdPASS)
+        {
+            Serial.println("[ByteFramework] Unable to start pipeline worker");
+            return false;
+        }
 
-        sendPacket(client, "message", value);
+        return true;
     }
 
     /**
-     * Sends a packet to the specified WebSocket client with a given type and value.
+     * Configures the server side heartbeat.
      *
-     * Constructs a JSON document containing the type and value, serializes it to a string,
-     * and sends the resulting string as a text message to the client.
+     * Every interval each client receives a WebSocket ping, browsers answer it
+     * automatically. Clients which do not answer within the timeout are considered
+     * half-open and get closed, which frees their slot and queued messages. Missing pongs
+     * are only checked on the next interval, so a dead client is closed after
+     * max(interval, timeout) at the earliest and after interval + timeout at the latest.
      *
-     * @param client A pointer to the AsyncWebSocketClient object representing the target client.
-     * @param type A string that specifies the type of the packet being sent.
-     * @param value A JsonObject that contains the value to be included in the packet.
+     * @param interval Time between two pings in milliseconds, 0 disables the heartbeat.
+     * @param timeout Time in milliseconds a client has to answer a ping.
      */
-    static void sendPacket(AsyncWebSocketClient* client, String type, JsonDocument value)
+    static void setHeartbeat(uint32_t interval, uint32_t timeout)
     {
-        JsonDocument doc;
-
-        doc["type"] = type;
-        doc["value"] = value;
+        heartbeatInterval = interval;
+        heartbeatTimeout = timeout;
+    }
 
-        String result = "";
+    /**
+     * Closes clients which did not send any packet for the given time,
+     * regardless of whether they still answer pings.
+     *
+     * @param timeout Idle time in milliseconds, 0 keeps idle clients connected.
+     */
+    static void setIdleTimeout(uint32_t timeout)
+    {
+        idleTimeout = timeout;
+    }
 
-        serializeJson(doc, result);
+    /**
+     * Limits the number of simultaneously connected clients, the oldest clients are closed first.
+     *
+     * @param count Maximum number of clients.
+     */
+    static void setMaxClients(uint16_t count)
+    {
+        maxClients = count;
+    }
 
-        client->text(result);
+    /**
+     * Configures the reconnect behaviour of framework.js.
+     *
+     * Clients wait a random time of up to delay * 2^attempt (capped by maxDelay) before each
+     * reconnect, so a reboot of the device does not make all clients reconnect at once.
+     *
+     * @param attempts Maximum number of reconnect attempts.
+     * @param delay Base delay in milliseconds.
+     * @param maxDelay Upper bound of the delay in milliseconds.
+     */
+    static void setReconnect(uint16_t attempts, uint32_t delay, uint32_t maxDelay)
+    {
+        maxReconnectAttempts = attempts;
+        reconnectDelay = delay;
+        reconnectMaxDelay = maxDelay;
+        configPacket.reset();
     }
 
     /**
-     * Handles WebSocket events by processing incoming messages, extracting information,
-     * and triggering corresponding events within the application.
+     * Configures the admission control, which lets the device degrade gracefully under load
+     * instead of failing allocations.
      *
-     * This method is intended to process specific types of WebSocket events, such as
-     * incoming text messages, and handle them accordingly by parsing JSON content and
-     * executing associated logic.
+     * HTTP page requests beyond the render budget or below the heap floor are answered with
+     * 503 and a Retry-After header, SPA navigations are answered without a body and retried
+     * by framework.js. Low priority frames (eval broadcasts, binding updates) are shed for
+     * clients with too many queued frames, responses to requests are always sent.
      *
-     * @param server A pointer to the AsyncWebSocket instance managing the WebSocket server.
-     * @param client A pointer to the AsyncWebSocketClient instance representing the connected client.
-     * @param type The type of WebSocket event being triggered (e.g., WS_EVT_DATA).
-     * @param arg A void pointer to additional arguments associated with the event (e.g., frame details).
-     * @param data A pointer to the data payload received in the WebSocket message.
-     * @param len The length of the data payload in bytes.
+     * Renders and the heap are not limited by default, only low priority frames are shed
+     * beyond 8 queued frames per client. A render slot is held until the response is sent
+     * completely: compressed pages are encoded while the client downloads them, so a slow
+     * client keeps its slot for the whole download. Choose the render budget with the
+     * slowest expected client in mind, otherwise fast clients receive 503 behind it.
+     *
+     * @param renders Maximum number of pages rendered at the same time, 0 for unlimited.
+     * @param clientQueue Maximum number of frames queued per client before low priority frames are shed, 0 for unlimited.
+     * @param heapFloor Free heap in bytes below which renders are refused and low priority frames are shed, 0 for none.
+     * @param retryAfter Seconds clients are asked to wait before trying again.
      */
-    static void onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
-                                 AwsEventType type, void* arg, uint8_t* data, size_t len)
+    static void setBudgets(uint16_t renders, uint16_t clientQueue, uint32_t heapFloor, uint32_t retryAfter = 2)
     {
-        if (type == WS_EVT_DATA)
-        {
-            AwsFrameInfo* info = (AwsFrameInfo*)arg;
+        renderBudget = renders;
+        clientQueueBudget = clientQueue;
+        PageService::heapFloor = heapFloor;
+        PageService::retryAfter = retryAfter;
+    }
 
-            if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT)
+    /**
+     * Current resource usage compared to the admission control budgets.
+     */
+    struct Usage
+    {
+        uint16_t renders; // Renders in progress.
+        uint16_t renderBudget;
+        uint32_t freeHeap;
+        uint32_t heapFloor;
+        uint16_t maxClientQueue; // Longest frame queue of all clients.
+        uint16_t clientQueueBudget;
+        uint32_t rejectedRenders; // Renders refused since boot.
+        uint32_t shedFrames; // Low priority frames dropped since boot.
+    };
+
+    /**
+     * Retrieves the current resource usage, e.g. to show it on a status page or to
+     * reduce the work of the sketch while the device is under pressure.
+     *
+     * @return The usage together with the configured budgets.
+     */
+    static Usage getUsage()
+    {
+        Usage usage = {};
+
+        usage.renders = activeRenders;
+        usage.renderBudget = renderBudget;
+        usage.freeHeap = ESP.getFreeHeap();
+        usage.heapFloor = heapFloor;
+        usage.clientQueueBudget = clientQueueBudget;
+        usage.rejectedRenders = rejectedRenders;
+        usage.shedFrames = shedFrames;
+
+        for (auto& client : socket.getClients())
+        {
+            if (client.status() == WS_CONNECTED && client.queueLen() > usage.maxClientQueue)
             {
-                String msg = "";
-                for (size_t i = 0; i < len; i++)
-                {
-                    msg += (char)data[i];
-                }
+                usage.maxClientQueue = client.queueLen();
+            }
+        }
 
-                // ArduinoJson 7 or so allow dynamic deserialization.
-                JsonDocument doc;
+        return usage;
+    }
 
-                // Try to deserialize JSON Packet.
-                deserializeJson(doc, msg);
+    /**
+     * Retrieves the round trip time measured with the last answered heartbeat ping.
+     *
+     * @param clientId The id of the WebSocket client.
+     * @return The round trip time in milliseconds, or 0 if not measured yet.
+     */
+    static uint32_t getRtt(uint32_t clientId)
+    {
+        std::lock_guard<std::mutex> lock(clientsLock);
 
-                DeserializationError error = deserializeJson(doc, msg);
+        auto it = clients.find(clientId);
 
-                if (error)
+        return it != clients.end() ? it->second.rtt : 0;
+    }
+
+    /**
+     * Runs periodic housekeeping, must be called from the sketch's loop().
+     *
+     * Samples bound components of viewed pages and pushes their changes, sends heartbeat
+     * pings, closes clients which did not answer the previous ping in time or were idle
+     * for too long, and releases disconnected clients (also with the heartbeat disabled).
+     */
+    static void loop()
+    {
+        const unsigned long now = millis();
+
+        // Release Clients which are disconnected and enforce Client Limit, independent of the Heartbeat.
+        socket.cleanupClients(maxClients);
+
+        updateBindings(now);
+
+        heartbeat(now);
+    }
+
+private:
+    /**
+     * Samples due bindings of viewed pages and pushes the changed values to the clients
+     * viewing them, one update packet per page and tick.
+     *
+     * Example:
+     * - Server: {"type":"update","value":{"temperature":"21.5","humidity":"40"}}
+     *
+     * @param now The current time in milliseconds.
+     */
+    static void updateBindings(unsigned long now)
+    {
+        std::set<Page*> viewed;
+
+        {
+            std::lock_guard<std::mutex> lock(clientsLock);
+
+            for (auto& client : clients)
+            {
+                if (client.second.page != nullptr)
                 {
-                    Serial.print(F("deserializeJson() failed: "));
-                    Serial.println(error.f_str());
-                    client->text("{\"error\":\"Invalid JSON\"}");
-                    return;
+                    viewed.insert(client.second.page);
                 }
+            }
+        }
 
-                const String type = String(doc["type"]);
-                const JsonObject value = doc["value"];
+        Bindings::tick(now, [&viewed](Page* page)
+        {
+            return viewed.count(page) > 0;
+        }, [](Page* page, JsonDocument& values)
+        {
+            JsonDocument doc;
 
-                // Example:
-                // - Client: {"type":"navigate","value":{"route":"/"}}
-                // - Server: {"type":"message","value":{"status":"error","message":"Page not found"}}
-                if (type.equalsIgnoreCase("navigate"))
-                {
-                    JsonDocument listeners;
+            doc["type"] = "update";
+            doc["value"] = values;
 
-                    // page => /
-                    // listeners => componentId
-                    //              - click
-                    //              - change
+            String packet = "";
 
+            serializeJson(doc, packet);
 
-                    // Get Page by Route.
-                    auto page = getPageById(String(value["route"]));
+            // Serialize once and share the Buffer between all Viewers.
+            AsyncWebSocketSharedBuffer buffer = std::make_shared<std::vector<uint8_t>>(
+                packet.c_str(), packet.c_str() + packet.length());
 
-                    if (page != nullptr)
-                    {
-                        // Loop trough Site Components.
-                        for (auto component : page->getComponents())
-                        {
-                            // Check if Component has a Listener.
-                            if (component->hasListeners() && component->getId() != "")
-                            {
-                                // Create JsonObject wich holds Listeners Object.
-                                JsonArray object = listeners[component->getId()].to<JsonArray>();
-
-                                // Loop trough Listeners and add them to Component ID Array.
-                                for (auto listener : component->getListener())
-                                {
-                                    object.add(listener.first.c_str());
-                                }
-                            }
-                        }
+            std::vector<uint32_t> viewers;
 
-                        // Send Welcome Packet (Listener Registration Packet).
-                        sendPacket(client, "welcome", listeners);
-                    }
-                    else
+            {
+                std::lock_guard<std::mutex> lock(clientsLock);
+
+                for (auto& client : clients)
+                {
+                    if (client.second.page == page)
                     {
-                        // Send response to client.
-                        sendMessage(client, true, "Page not found");
+                        viewers.push_back(client.first);
                     }
                 }
-                // Example:
-                // - Client: {"type": "execute", "value": {"route": "/", "component": "test123","event": "click", "data": "xyz" }}
-                else if (type.equalsIgnoreCase("execute"))
-                {
-                    const char* eventId = value["event"];
-                    const JsonObject eventData = value["data"];
+            }
 
-                    if (eventId != nullptr)
-                    {
-                        // Try to get page by id.
-                        auto page = getPageById(String(value["route"]));
+            bool shed = false;
 
-                        if (page != nullptr)
-                        {
-                            // Try to get component by id.
-                            auto component = page->getComponentById(String(value["component"]));
+            for (uint32_t clientId : viewers)
+            {
+                AsyncWebSocketClient* client = socket.client(clientId);
 
-                            if (component != nullptr)
-                            {
-                                // Trigger the right listener of the component on the right page.
-                                component->triggerEvent(eventId, eventData);
+                if (client == nullptr)
+                {
+                    continue;
+                }
 
-                                // Send response to client.
-                                sendMessage(client, false, "Event processed");
-                            }
-                            else
-                            {
-                                // Send response to client.
-                                sendMessage(client, true, "Component not found");
-                            }
-                        }
-                        else
-                        {
-                            // Send response to client.
-                            sendMessage(client, true, "Page not found");
-                        }
-                    }
-                    else
-                    {
-                        // Send response to client.
-                        sendMessage(client, true, "No event specified");
-                    }
+                // Updates are low Priority, a Client which does not keep up skips them.
+                if (admitFrame(client))
+                {
+                    client->text(buffer);
                 }
                 else
                 {
-                    sendMessage(client, true, "Unknown event type");
-                    sendMessage(client, true, type.c_str());
+                    shed = true;
                 }
             }
-        }
+
+            // Resend the Values on the next Sample, they would be suppressed as unchanged otherwise.
+            if (shed)
+            {
+                Bindings::resync(page);
+            }
+        });
     }
 
-public:
     /**
-     * Initializes and assigns the provided AsyncWebServer instance to the internal server.
+     * Sends heartbeat pings and closes clients which did not answer the previous ping
+     * in time or were idle for too long.
      *
-     * Add WebSocket Channel for Backend Communication on Route /ws.
-     *
-     * @param srv A pointer to the AsyncWebServer instance to be used by the system.
+     * @param now The current time in milliseconds.
      */
-    static void begin(AsyncWebServer* srv)
+    static void heartbeat(unsigned long now)
     {
-        if (!SPIFFS.begin(true))
+        if (heartbeatInterval == 0 || now - lastHeartbeat < heartbeatInterval)
         {
-            Serial.println("Fehler beim Mounten von SPIFFS");
             return;
         }
 
-        server = srv;
+        lastHeartbeat = now;
 
-        // Register Channel Listener.
-        socket.onEvent(onWebSocketEvent);
+        std::vector<uint32_t> expired;
+        std::vector<uint32_t> alive;
 
-        // Service Static Files.
-        server->serveStatic("/static", SPIFFS, "/");
+        // Only Ids are collected, the AsyncTCP Task may delete Clients until they are looked up again.
+        {
+            std::lock_guard<std::mutex> lock(clientsLock);
 
-        // Add WebSocket to AsyncServer.
-        server->addHandler(&socket);
+            for (auto& entry : clients)
+            {
+                ClientState& state = entry.second;
+
+                // Close half-open Clients and Clients without Activity.
+                if ((state.awaitingPong && now - state.pingSentAt > heartbeatTimeout) ||
+                    (idleTimeout > 0 && now - state.lastActivity > idleTimeout))
+                {
+                    expired.push_back(entry.first);
+                }
+                else if (!state.awaitingPong)
+                {
+                    state.pingSentAt = now;
+                    state.awaitingPong = true;
+
+                    alive.push_back(entry.first);
+                }
+            }
+        }
+
+        // Talk to the Clients outside the Lock, their Events take it as well.
+        for (uint32_t clientId : expired)
+        {
+            AsyncWebSocketClient* client = socket.client(clientId);
+
+            if (client != nullptr)
+            {
+                client->close();
+            }
+        }
+
+        for (uint32_t clientId : alive)
+        {
+            AsyncWebSocketClient* client = socket.client(clientId);
+
+            if (client != nullptr)
+            {
+                client->ping();
+            }
+        }
     }
 
+public:
     /**
      * Retrieves a Page object corresponding to the given unique identifier string.
      *
@@ -287,10 +1669,99 @@ public:
     {
         pages[path] = page;
 
-        server->on(path.c_str(), HTTP_GET, [=](AsyncWebServerRequest* request)
+        server->on(path.c_str(), HTTP_GET, [page](AsyncWebServerRequest* request)
+        {
+            sendPage(request, page);
+        });
+
+        return page;
+    }
+
+    /**
+     * Adds a page which never changes after setup() as exported page.
+     *
+     * The page is rendered once and written gzip compressed to the filesystem together with
+     * a manifest of its listeners. Requests are served from the file, the Page object and its
+     * components are deleted after the export, so they take neither boot time nor RAM on later
+     * boots: the builder is only called again when the version differs from the exported one.
+     *
+     * Components of exported pages do not exist at runtime, register their handlers with on()
+     * before calling this method. The manifest holds the listeners added to the components and
+     * the handlers of components which exist on the page, listeners added with addListener()
+     * only mark the event and are dropped with the components. Events without a handler and
+     * handlers without an event are reported on the serial console at every boot. Increase the
+     * version whenever the layout or the handlers change.
+     * Must be called after begin().
+     *
+     * @param path The route of the page.
+     * @param version The version of the layout.
+     * @param builder Creates the page with new, the page and all of its components are deleted after the export.
+     * @return True if the page is served, false if the export could not be written.
+     */
+    static bool addStaticPage(const String& path, uint32_t version, std::function<Page*()> builder)
+    {
+        char name[9];
+
+        snprintf(name, sizeof(name), "%08x", (unsigned int)Component::hashId(path));
+
+        StaticPage& entry = staticPages[path];
+        const String manifestPath = String(STATIC_DIR) + "/" + name + ".json";
+
+        entry.file = String(STATIC_DIR) + "/" + name + ".html";
+
+        JsonDocument manifest;
+        bool current = false;
+
+        if (SPIFFS.exists(manifestPath) && SPIFFS.exists(entry.file + ".gz"))
+        {
+            File file = SPIFFS.open(manifestPath, FILE_READ);
+
+            current = file && !deserializeJson(manifest, file) &&
+                (manifest["version"] | 0u) == version && String(manifest["route"]) == path;
+
+            file.close();
+        }
+
+        // Export on first Boot or when the Layout changed.
+        if (!current)
+        {
+            Page* page = builder();
+            const bool exported = exportPage(path, version, page, entry, manifestPath);
+
+            releaseComponents(page->getComponents());
+            delete page;
+
+            if (!exported)
+            {
+                Serial.println("[ByteFramework] Unable to export page " + path);
+
+                entry.file = "";
+                return false;
+            }
+
+            File file = SPIFFS.open(manifestPath, FILE_READ);
+
+            deserializeJson(manifest, file);
+
+            file.close();
+        }
+
+        checkHandlers(path, entry, manifest["listeners"]);
+
+        entry.listenerJson = "";
+
+        serializeJson(manifest["listeners"], entry.listenerJson);
+
+        const String packet = "{\"type\":\"welcome\",\"value\":" + entry.listenerJson + "}";
+
+        entry.welcome = std::make_shared<std::vector<uint8_t>>(packet.c_str(), packet.c_str() + packet.length());
+
+        const String file = entry.file;
+
+        server->on(path.c_str(), HTTP_GET, [file](AsyncWebServerRequest* request)
         {
-            // Prepare custom response.
-            AsyncWebServerResponse* response = request->beginResponse(200, "text/html", page->render());
+            // The File Response picks the .gz File and sets the Content-Encoding itself.
+            AsyncWebServerResponse* response = request->beginResponse(SPIFFS, file, "text/html");
 
             // Add Framework Header.
             response->addHeader("X-Framework", "ByteFramework");
@@ -299,28 +1770,69 @@ public:
             request->send(response);
         });
 
-        return page;
+        return true;
+    }
+
+    /**
+     * @brief Registers a handler for an event of a component on an exported page.
+     *
+     * @param route The route of the exported page.
+     * @param componentId The id of the component.
+     * @param eventId The event, e.g. "click".
+     * @param callback The function to be executed, it receives the event data.
+     */
+    static void on(const String& route, const String& componentId, const String& eventId,
+                   std::function<void(JsonObject)> callback)
+    {
+        on(route, componentId, eventId, [callback](JsonObject data, JsonObject result)
+        {
+            callback(data);
+        });
+    }
+
+    /**
+     * @brief Registers a handler for an event of a component on an exported page which returns a result.
+     *
+     * @param route The route of the exported page.
+     * @param componentId The id of the component.
+     * @param eventId The event, e.g. "click".
+     * @param callback The function to be executed, it receives the event data and the result object to fill.
+     */
+    static void on(const String& route, const String& componentId, const String& eventId,
+                   std::function<void(JsonObject, JsonObject)> callback)
+    {
+        staticPages[route].listeners[componentId][eventId] = callback;
     }
 
     /**
      * Executes a command string on all connected clients by sending it
      * as a JSON packet.
      *
-     * Iterates through the list of connected clients retrieved from the
-     * socket and sends a JSON-encoded packet containing the specified
-     * command for evaluation.
+     * Serializes a JSON-encoded packet containing the specified command once
+     * and sends it to every connected client retrieved from the socket.
      *
      * @param cmd The command string to be evaluated and sent to clients.
+     * @param droppable True to skip clients over their queue budget (see setBudgets()),
+     *                  for commands which are repeated anyway, e.g. periodic refreshes.
      */
-    static void eval(const String cmd)
+    static void eval(const String cmd, bool droppable = false)
     {
-        for (auto& client : socket.getClients())
-        {
-            JsonDocument doc;
+        JsonDocument doc;
 
-            doc["value"] = cmd;
+        doc["type"] = "eval";
+        doc["value"]["value"] = cmd;
 
-            sendPacket(&client, "eval", doc);
+        // Serialize once for all Clients.
+        String result = "";
+
+        serializeJson(doc, result);
+
+        for (auto& client : socket.getClients())
+        {
+            if (client.status() == WS_CONNECTED && (!droppable || admitFrame(&client)))
+            {
+                client.text(result);
+            }
         }
     }
 };
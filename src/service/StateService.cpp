@@ -0,0 +1,18 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "StateService.h"
+
+// Define default Filesystem (set by begin).
+fs::FS* StateService::fs = nullptr;
+
+// Define restored and tracked States.
+std::map<String, String> StateService::values = std::map<String, String>();
+std::map<String, StateService::Tracked> StateService::tracked = std::map<String, StateService::Tracked>();
+
+// Define default Write Coalescing Settings.
+uint32_t StateService::flushInterval = 5000;
+unsigned long StateService::lastFlush = 0;
+size_t StateService::compactThreshold = 8192;
+size_t StateService::journalSize = 0;
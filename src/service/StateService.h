@@ -0,0 +1,386 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef STATESERVICE_H
+#define STATESERVICE_H
+
+#include <map>
+#include <vector>
+#include <Arduino.h>
+#include <FS.h>
+#include <SPIFFS.h>
+#include <core/components/Component.h>
+
+/**
+ * Persists the state of components (input values, checkboxes, ...) across reboots.
+ *
+ * Changes are not written on every event. StateService::loop() collects the changed
+ * components on a timer and appends them in one write to a journal file. When the
+ * journal grows too large it is compacted into a snapshot holding only the latest
+ * value of every key. On startup the snapshot and the journal are replayed once.
+ *
+ * Record layout (snapshot and journal):
+ *   [0xB5][key length u16][value length u16][key][value][checksum u8]
+ */
+class StateService
+{
+private:
+    /**
+     * Filesystem holding the snapshot and journal files.
+     */
+    static fs::FS* fs;
+
+    /**
+     * Latest known value of every key, restored from flash or taken from a tracked component.
+     */
+    static std::map<String, String> values;
+
+    /**
+     * A component whose state is persisted together with the state version written last.
+     */
+    struct Tracked
+    {
+        Component* component;
+        uint32_t version;
+    };
+
+    /**
+     * Tracked components, keyed by their persistence key.
+     */
+    static std::map<String, Tracked> tracked;
+
+    /**
+     * Time between two journal writes in milliseconds.
+     */
+    static uint32_t flushInterval;
+    static unsigned long lastFlush;
+
+    /**
+     * Journal size in bytes which triggers a compaction into the snapshot.
+     */
+    static size_t compactThreshold;
+    static size_t journalSize;
+
+    /**
+     * The files live in the private /bf/ directory, which PageService never serves.
+     */
+    static constexpr const char* SNAPSHOT_PATH = "/bf/state.snap";
+    static constexpr const char* SNAPSHOT_TMP_PATH = "/bf/state.tmp";
+    static constexpr const char* JOURNAL_PATH = "/bf/state.log";
+    static constexpr uint8_t RECORD_MAGIC = 0xB5;
+
+    /**
+     * Appends a single record to the given buffer.
+     *
+     * @param buffer The buffer receiving the record.
+     * @param key The persistence key.
+     * @param value The serialized state.
+     */
+    static void appendRecord(std::vector<uint8_t>& buffer, const String& key, const String& value)
+    {
+        const uint16_t keyLength = key.length();
+        const uint16_t valueLength = value.length();
+        uint8_t checksum = 0;
+
+        buffer.push_back(RECORD_MAGIC);
+        buffer.push_back(keyLength & 0xFF);
+        buffer.push_back(keyLength >> 8);
+        buffer.push_back(valueLength & 0xFF);
+        buffer.push_back(valueLength >> 8);
+
+        for (size_t i = 0; i < keyLength; i++)
+        {
+            buffer.push_back(key[i]);
+            checksum += key[i];
+        }
+
+        for (size_t i = 0; i < valueLength; i++)
+        {
+            buffer.push_back(value[i]);
+            checksum += value[i];
+        }
+
+        buffer.push_back(checksum);
+    }
+
+    /**
+     * Reads all records of a file into the value map, later records overwrite earlier ones.
+     *
+     * Reading stops at the first damaged record, e.g. a journal write torn by a power loss.
+     *
+     * @param path The file to read.
+     * @return The number of bytes of valid records in the file.
+     */
+    static size_t replay(const char* path)
+    {
+        if (!fs->exists(path))
+        {
+            return 0;
+        }
+
+        File file = fs->open(path, FILE_READ);
+
+        if (!file)
+        {
+            return 0;
+        }
+
+        // Read the whole File at once, this is way faster than many small Reads.
+        std::vector<uint8_t> buffer(file.size());
+        const size_t length = file.read(buffer.data(), buffer.size());
+
+        file.close();
+
+        size_t position = 0;
+
+        while (position + 6 <= length && buffer[position] == RECORD_MAGIC)
+        {
+            const size_t keyLength = buffer[position + 1] | (buffer[position + 2] << 8);
+            const size_t valueLength = buffer[position + 3] | (buffer[position + 4] << 8);
+            const size_t end = position + 5 + keyLength + valueLength;
+
+            if (end + 1 > length)
+            {
+                break;
+            }
+
+            uint8_t checksum = 0;
+
+            for (size_t i = position + 5; i < end; i++)
+            {
+                checksum += buffer[i];
+            }
+
+            if (checksum != buffer[end])
+            {
+                break;
+            }
+
+            String key;
+            String value;
+
+            key.concat((const char*)&buffer[position + 5], keyLength);
+            value.concat((const char*)&buffer[position + 5 + keyLength], valueLength);
+
+            values[key] = value;
+
+            position = end + 1;
+        }
+
+        return position;
+    }
+
+public:
+    /**
+     * Restores the persisted state from flash.
+     *
+     * Must be called before components are tracked. The filesystem has to be mounted
+     * already, PageService::begin() mounts SPIFFS which is used by default.
+     *
+     * @param filesystem The filesystem holding the state files, e.g. SPIFFS or LittleFS.
+     * @return The number of restored keys.
+     */
+    static size_t begin(fs::FS& filesystem = SPIFFS)
+    {
+        fs = &filesystem;
+        values.clear();
+
+        // Only LittleFS has Directories, SPIFFS stores the Path as Name.
+        fs->mkdir("/bf");
+
+        // A Compaction was interrupted before the new Snapshot was renamed.
+        if (fs->exists(SNAPSHOT_PATH))
+        {
+            replay(SNAPSHOT_PATH);
+        }
+        else
+        {
+            replay(SNAPSHOT_TMP_PATH);
+        }
+
+        journalSize = replay(JOURNAL_PATH);
+
+        // Drop a damaged Tail of the Journal, new Records would be unreadable behind it.
+        if (fs->exists(JOURNAL_PATH))
+        {
+            File journal = fs->open(JOURNAL_PATH, FILE_READ);
+            const bool damaged = journal.size() != journalSize;
+
+            journal.close();
+
+            if (damaged)
+            {
+                compact();
+            }
+        }
+
+        lastFlush = millis();
+
+        return values.size();
+    }
+
+    /**
+     * Persists the state of a component under the given key.
+     *
+     * If a value was restored for the key, it is applied to the component immediately.
+     *
+     * @param key A unique key, e.g. route and component id.
+     * @param component The component whose state should be persisted.
+     * @return The given component.
+     */
+    static Component* track(const String& key, Component* component)
+    {
+        std::lock_guard<std::recursive_mutex> guard(Component::stateLock);
+        auto it = values.find(key);
+
+        if (it != values.end())
+        {
+            component->setState(it->second);
+        }
+
+        tracked[key] = {component, component->getStateVersion()};
+
+        return component;
+    }
+
+    /**
+     * Sets the time between two journal writes.
+     *
+     * @param interval The interval in milliseconds.
+     */
+    static void setFlushInterval(uint32_t interval)
+    {
+        flushInterval = interval;
+    }
+
+    /**
+     * Sets the journal size which triggers a compaction.
+     *
+     * @param bytes The journal size in bytes.
+     */
+    static void setCompactThreshold(size_t bytes)
+    {
+        compactThreshold = bytes;
+    }
+
+    /**
+     * Writes pending changes once the flush interval elapsed, must be called from the sketch's loop().
+     *
+     * Writing happens in the loop task, so the network task is never blocked by flash access.
+     */
+    static void loop()
+    {
+        if (fs == nullptr || millis() - lastFlush < flushInterval)
+        {
+            return;
+        }
+
+        flush();
+    }
+
+    /**
+     * Appends the state of all changed components to the journal in a single write
+     * and compacts the journal if it exceeds the threshold.
+     *
+     * The states are collected under Component::stateLock, listeners may change them
+     * on another task. The flash write happens after the lock was released.
+     */
+    static void flush()
+    {
+        lastFlush = millis();
+
+        std::vector<uint8_t> buffer;
+        std::unique_lock<std::recursive_mutex> guard(Component::stateLock);
+
+        for (auto& entry : tracked)
+        {
+            Tracked& item = entry.second;
+            const uint32_t version = item.component->getStateVersion();
+
+            if (version == item.version)
+            {
+                continue;
+            }
+
+            item.version = version;
+
+            const String state = item.component->getState();
+            String& persisted = values[entry.first];
+
+            // Skip Changes which were reverted in the meantime.
+            if (state != persisted)
+            {
+                persisted = state;
+
+                appendRecord(buffer, entry.first, state);
+            }
+        }
+
+        guard.unlock();
+
+        if (buffer.empty())
+        {
+            return;
+        }
+
+        File file = fs->open(JOURNAL_PATH, FILE_APPEND);
+
+        if (!file)
+        {
+            Serial.println("[ByteFramework] Unable to open state journal");
+            return;
+        }
+
+        journalSize += file.write(buffer.data(), buffer.size());
+
+        file.close();
+
+        if (journalSize > compactThreshold)
+        {
+            compact();
+        }
+    }
+
+    /**
+     * Rewrites the snapshot with the latest value of every key and clears the journal.
+     *
+     * The new snapshot is written to a temporary file first, so a power loss never
+     * leaves the device without a readable snapshot.
+     */
+    static void compact()
+    {
+        std::vector<uint8_t> buffer;
+
+        for (auto& entry : values)
+        {
+            appendRecord(buffer, entry.first, entry.second);
+        }
+
+        File file = fs->open(SNAPSHOT_TMP_PATH, FILE_WRITE);
+
+        if (!file)
+        {
+            Serial.println("[ByteFramework] Unable to write state snapshot");
+            return;
+        }
+
+        const size_t written = file.write(buffer.data(), buffer.size());
+
+        file.close();
+
+        if (written != buffer.size())
+        {
+            Serial.println("[ByteFramework] Unable to write state snapshot");
+            return;
+        }
+
+        fs->remove(SNAPSHOT_PATH);
+        fs->rename(SNAPSHOT_TMP_PATH, SNAPSHOT_PATH);
+        fs->remove(JOURNAL_PATH);
+
+        journalSize = 0;
+    }
+};
+
+#endif
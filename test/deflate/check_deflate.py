@@ -0,0 +1,99 @@
+#
+# Host check of the Deflate encoder (src/core/Deflate.cpp).
+#
+# Builds test/deflate/deflate_check.cpp with the host compiler, compresses several inputs in
+# raw, zlib and gzip framing with different source and read chunk sizes and decompresses the
+# result with Python's zlib and gzip modules.
+#
+# Usage:
+#   python test/deflate/check_deflate.py
+#   CXX=clang++ python test/deflate/check_deflate.py
+#
+# Exits with an error if any stream does not decompress to its input.
+#
+
+import gzip
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import zlib
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+
+FORMATS = {
+    0: ("raw", lambda data: zlib.decompress(data, -15)),
+    1: ("zlib", lambda data: zlib.decompress(data, 15)),
+    2: ("gzip", gzip.decompress),
+}
+
+# (source chunk, read chunk): byte by byte, odd sizes and the sizes used by PageService.
+CHUNKS = [(1, 1), (7, 13), (100, 3), (1436, 1436), (4096, 4096)]
+
+
+def inputs():
+    rng = random.Random(1)
+
+    page = "".join(
+        f'<div id="row{i}" class="row"><label id="l{i}">Value {i}</label>'
+        f'<input id="i{i}" type="text" value="{rng.randint(0, 9999)}"></div>'
+        for i in range(800))
+
+    return {
+        "empty": b"",
+        "single": b"a",
+        "short": b"abc",
+        "repeat": b"a" * 5000,
+        "random": bytes(rng.getrandbits(8) for _ in range(20000)),
+        "text": ("The quick brown fox jumps over the lazy dog. " * 300).encode(),
+        "page": page.encode(),
+    }
+
+
+def build(directory):
+    binary = os.path.join(directory, "deflate_check")
+    compiler = os.environ.get("CXX", "c++")
+
+    subprocess.run([compiler, "-std=c++17", "-O2", "-Wall", "-I", os.path.join(ROOT, "src"),
+                    os.path.join(ROOT, "src", "core", "Deflate.cpp"),
+                    os.path.join(ROOT, "test", "deflate", "deflate_check.cpp"),
+                    "-o", binary], check=True)
+
+    return binary
+
+
+def main():
+    failures = 0
+
+    with tempfile.TemporaryDirectory() as directory:
+        binary = build(directory)
+
+        for name, data in inputs().items():
+            for fmt, (format_name, decompress) in FORMATS.items():
+                for source_chunk, read_chunk in CHUNKS:
+                    run = subprocess.run([binary, str(fmt), str(source_chunk), str(read_chunk)],
+                                         input=data, capture_output=True)
+                    label = f"{name} {format_name} {source_chunk}/{read_chunk}"
+
+                    try:
+                        ok = run.returncode == 0 and decompress(run.stdout) == data
+                    except Exception as error:
+                        print(f"FAIL {label}: {error}")
+                        failures += 1
+                        continue
+
+                    if not ok:
+                        print(f"FAIL {label}: exit code {run.returncode}")
+                        failures += 1
+
+            run = subprocess.run([binary, "2", "4096", "4096"], input=data, capture_output=True)
+            print(f"{name:8} {len(data):6} -> {len(run.stdout):6} bytes (gzip)")
+
+    print("failures:", failures)
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
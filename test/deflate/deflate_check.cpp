@@ -0,0 +1,65 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+// Host build of the Deflate encoder, used by check_deflate.py.
+//
+// Usage: deflate_check <format 0=raw 1=zlib 2=gzip> <source chunk> <read chunk> < input > output
+
+#include <core/Deflate.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        fprintf(stderr, "Usage: %s <format> <source chunk> <read chunk>\n", argv[0]);
+        return 1;
+    }
+
+    const auto format = (Deflate::Format)atoi(argv[1]);
+    const size_t sourceChunk = atoi(argv[2]);
+    const size_t readChunk = atoi(argv[3]);
+
+    // Read the whole Input, the Source hands it out in small Pieces.
+    std::vector<uint8_t> input;
+    int c;
+
+    while ((c = getchar()) != EOF)
+    {
+        input.push_back(c);
+    }
+
+    size_t position = 0;
+
+    auto* encoder = new Deflate([&](uint8_t* buffer, size_t max)
+    {
+        size_t count = input.size() - position;
+
+        count = count < max ? count : max;
+        count = count < sourceChunk ? count : sourceChunk;
+
+        memcpy(buffer, input.data() + position, count);
+        position += count;
+
+        return count;
+    }, format);
+
+    std::vector<uint8_t> output(readChunk);
+    size_t count;
+
+    while ((count = encoder->read(output.data(), output.size())) > 0)
+    {
+        fwrite(output.data(), 1, count, stdout);
+    }
+
+    const bool finished = encoder->finished();
+
+    delete encoder;
+
+    return finished ? 0 : 2;
+}
@@ -0,0 +1,290 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+
+// Sanitizers replace malloc themselves, their Builds report an unused Heap.
+#if defined(__GLIBC__) && !defined(__SANITIZE_THREAD__) && !defined(__SANITIZE_ADDRESS__)
+#define HOST_COUNT_HEAP
+#include <malloc.h>
+#endif
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace
+{
+    const auto startedAt = std::chrono::steady_clock::now();
+
+    /**
+     * Heap accounting: bytes allocated by the process, the level at the start of the
+     * sketch counts as empty heap.
+     */
+    std::atomic<int64_t> allocated(0);
+    std::atomic<int64_t> allocatedPeak(0);
+    int64_t allocatedBase = 0;
+}
+
+uint32_t hostHeapSize = 320 * 1024;
+
+/**
+ * Starts the heap accounting of the sketch, called by the host main before setup().
+ */
+void hostResetHeap()
+{
+    allocatedBase = allocated.load();
+    allocatedPeak = allocatedBase;
+}
+
+#ifdef HOST_COUNT_HEAP
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* pointer);
+}
+
+namespace
+{
+    void track(void* pointer, int64_t sign)
+    {
+        if (pointer == nullptr)
+        {
+            return;
+        }
+
+        const int64_t now = allocated += sign * (int64_t)malloc_usable_size(pointer);
+        int64_t peak = allocatedPeak.load();
+
+        while (now > peak && !allocatedPeak.compare_exchange_weak(peak, now))
+        {
+        }
+    }
+}
+
+// Count every Allocation of the Process, ArduinoJson allocates with malloc() directly.
+extern "C"
+{
+    void* malloc(size_t size) noexcept
+    {
+        void* pointer = __libc_malloc(size);
+
+        track(pointer, 1);
+
+        return pointer;
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        void* pointer = __libc_calloc(count, size);
+
+        track(pointer, 1);
+
+        return pointer;
+    }
+
+    void* realloc(void* pointer, size_t size) noexcept
+    {
+        track(pointer, -1);
+
+        void* moved = __libc_realloc(pointer, size);
+
+        // A failed Realloc keeps the old Block.
+        track(moved != nullptr || size == 0 ? moved : pointer, 1);
+
+        return moved;
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        void* pointer = __libc_memalign(alignment, size);
+
+        track(pointer, 1);
+
+        return pointer;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        return memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        *result = memalign(alignment, size);
+
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void free(void* pointer) noexcept
+    {
+        track(pointer, -1);
+
+        __libc_free(pointer);
+    }
+}
+#endif
+
+uint32_t EspClass::getHeapSize()
+{
+    return hostHeapSize;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    const int64_t used = allocated - allocatedBase;
+
+    return used < (int64_t)hostHeapSize ? hostHeapSize - (used > 0 ? used : 0) : 0;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+    const int64_t used = allocatedPeak - allocatedBase;
+
+    return used < (int64_t)hostHeapSize ? hostHeapSize - (used > 0 ? used : 0) : 0;
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+    return getFreeHeap();
+}
+
+unsigned long millis()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startedAt).count();
+}
+
+unsigned long micros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt).count();
+}
+
+void delay(unsigned long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield()
+{
+    std::this_thread::yield();
+}
+
+uint32_t esp_random()
+{
+    static std::random_device device;
+    static std::mutex lock;
+    std::lock_guard<std::mutex> guard(lock);
+
+    return device();
+}
+
+long random(long max)
+{
+    return max > 0 ? esp_random() % max : 0;
+}
+
+long random(long min, long max)
+{
+    return min < max ? min + random(max - min) : min;
+}
+
+/**
+ * A FreeRTOS task: a thread together with its notification value.
+ */
+struct HostTask
+{
+    std::mutex lock;
+    std::condition_variable notified;
+    uint32_t notifications = 0;
+};
+
+namespace
+{
+    thread_local HostTask* currentTask = nullptr;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core)
+{
+    // Tasks run forever, like the Pipeline Tasks on the Device.
+    HostTask* task = new HostTask();
+
+    if (handle != nullptr)
+    {
+        *handle = task;
+    }
+
+    std::thread([task, function, parameter]
+    {
+        currentTask = task;
+
+        function(parameter);
+    }).detach();
+
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    // Threads which were not created as Task (main, network) get their Handle on first Use.
+    if (currentTask == nullptr)
+    {
+        currentTask = new HostTask();
+    }
+
+    return currentTask;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait)
+{
+    HostTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> guard(task->lock);
+
+    if (ticksToWait == portMAX_DELAY)
+    {
+        task->notified.wait(guard, [task] { return task->notifications > 0; });
+    }
+    else
+    {
+        task->notified.wait_for(guard, std::chrono::milliseconds(ticksToWait * portTICK_PERIOD_MS),
+                                [task] { return task->notifications > 0; });
+    }
+
+    const uint32_t value = task->notifications;
+
+    if (value > 0)
+    {
+        task->notifications = clearOnExit ? 0 : value - 1;
+    }
+
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    {
+        std::lock_guard<std::mutex> guard(task->lock);
+
+        task->notifications++;
+    }
+
+    task->notified.notify_one();
+
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    delay(ticks * portTICK_PERIOD_MS);
+}
@@ -0,0 +1,1101 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <ESPAsyncWebServer.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+uint16_t hostServerPort = 0;
+
+namespace
+{
+    /**
+     * Largest frame or request accepted from a client.
+     */
+    constexpr size_t MAX_INPUT = 64 * 1024;
+
+    /**
+     * Size of the pieces a chunked response is filled with, about one TCP segment.
+     */
+    constexpr size_t CHUNK = 1436;
+
+    /**
+     * SHA-1 of the given data, only used for the WebSocket handshake.
+     */
+    std::string sha1(const std::string& data)
+    {
+        uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+        std::string message = data;
+        const uint64_t bits = (uint64_t)data.size() * 8;
+
+        message += (char)0x80;
+
+        while (message.size() % 64 != 56)
+        {
+            message += (char)0;
+        }
+
+        for (int shift = 56; shift >= 0; shift -= 8)
+        {
+            message += (char)(bits >> shift);
+        }
+
+        auto rotate = [](uint32_t value, int count) { return (value << count) | (value >> (32 - count)); };
+
+        for (size_t block = 0; block < message.size(); block += 64)
+        {
+            uint32_t w[80];
+
+            for (int i = 0; i < 16; i++)
+            {
+                w[i] = (uint8_t)message[block + i * 4] << 24 | (uint8_t)message[block + i * 4 + 1] << 16 |
+                       (uint8_t)message[block + i * 4 + 2] << 8 | (uint8_t)message[block + i * 4 + 3];
+            }
+
+            for (int i = 16; i < 80; i++)
+            {
+                w[i] = rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            }
+
+            uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+            for (int i = 0; i < 80; i++)
+            {
+                uint32_t f, k;
+
+                if (i < 20)
+                {
+                    f = (b & c) | (~b & d);
+                    k = 0x5A827999;
+                }
+                else if (i < 40)
+                {
+                    f = b ^ c ^ d;
+                    k = 0x6ED9EBA1;
+                }
+                else if (i < 60)
+                {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8F1BBCDC;
+                }
+                else
+                {
+                    f = b ^ c ^ d;
+                    k = 0xCA62C1D6;
+                }
+
+                const uint32_t next = rotate(a, 5) + f + e + k + w[i];
+
+                e = d;
+                d = c;
+                c = rotate(b, 30);
+                b = a;
+                a = next;
+            }
+
+            h[0] += a;
+            h[1] += b;
+            h[2] += c;
+            h[3] += d;
+            h[4] += e;
+        }
+
+        std::string digest;
+
+        for (uint32_t value : h)
+        {
+            for (int shift = 24; shift >= 0; shift -= 8)
+            {
+                digest += (char)(value >> shift);
+            }
+        }
+
+        return digest;
+    }
+
+    std::string base64(const std::string& data)
+    {
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string result;
+
+        for (size_t i = 0; i < data.size(); i += 3)
+        {
+            const uint32_t chunk = (uint8_t)data[i] << 16 |
+                                   (i + 1 < data.size() ? (uint8_t)data[i + 1] << 8 : 0) |
+                                   (i + 2 < data.size() ? (uint8_t)data[i + 2] : 0);
+
+            result += alphabet[(chunk >> 18) & 63];
+            result += alphabet[(chunk >> 12) & 63];
+            result += i + 1 < data.size() ? alphabet[(chunk >> 6) & 63] : '=';
+            result += i + 2 < data.size() ? alphabet[chunk & 63] : '=';
+        }
+
+        return result;
+    }
+
+    String urlDecode(const String& text)
+    {
+        String result;
+
+        for (unsigned int i = 0; i < text.length(); i++)
+        {
+            if (text[i] == '%' && i + 2 < text.length())
+            {
+                result += (char)strtol(text.substring(i + 1, i + 3).c_str(), nullptr, 16);
+                i += 2;
+            }
+            else
+            {
+                result += text[i] == '+' ? ' ' : text[i];
+            }
+        }
+
+        return result;
+    }
+
+    const char* reasonPhrase(int code)
+    {
+        switch (code)
+        {
+        case 101: return "Switching Protocols";
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "";
+        }
+    }
+
+    String contentTypeOf(const String& path)
+    {
+        if (path.endsWith(".html") || path.endsWith(".htm")) return "text/html";
+        if (path.endsWith(".css")) return "text/css";
+        if (path.endsWith(".js")) return "application/javascript";
+        if (path.endsWith(".json")) return "application/json";
+        if (path.endsWith(".png")) return "image/png";
+        if (path.endsWith(".svg")) return "image/svg+xml";
+        if (path.endsWith(".ico")) return "image/x-icon";
+        return "text/plain";
+    }
+}
+
+/**
+ * A TCP connection of the host server, owned by the network thread.
+ *
+ * Starts as HTTP connection and becomes a WebSocket connection after the handshake.
+ */
+class HostConnection
+{
+public:
+    AsyncWebServer* server;
+    int fd;
+    std::string input;
+    std::string output;
+    AsyncWebSocket* socket = nullptr;
+    AsyncWebSocketClient* client = nullptr;
+    bool answered = false;
+    bool closing = false;
+    bool closed = false;
+    uint8_t messageOpcode = WS_TEXT;
+    uint32_t messageNumber = 0;
+
+    HostConnection(AsyncWebServer* server, int fd) : server(server), fd(fd) {}
+
+    void receive()
+    {
+        char buffer[4096];
+
+        for (;;)
+        {
+            const ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+
+            if (count > 0)
+            {
+                input.append(buffer, count);
+                continue;
+            }
+
+            if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            {
+                closed = true;
+            }
+
+            break;
+        }
+
+        if (socket == nullptr)
+        {
+            parseRequest();
+        }
+
+        if (socket != nullptr)
+        {
+            parseFrames();
+        }
+
+        if (input.size() > MAX_INPUT)
+        {
+            closed = true;
+        }
+    }
+
+    bool wantsWrite()
+    {
+        if (!output.empty())
+        {
+            return true;
+        }
+
+        if (client == nullptr)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::recursive_mutex> guard(socket->_lock);
+
+        return !client->_queue.empty();
+    }
+
+    void flush()
+    {
+        if (!write(output))
+        {
+            return;
+        }
+
+        if (client != nullptr)
+        {
+            std::lock_guard<std::recursive_mutex> guard(socket->_lock);
+
+            while (!client->_queue.empty())
+            {
+                std::vector<uint8_t>& frame = client->_queue.front();
+                const ssize_t count = send(fd, frame.data() + client->_written, frame.size() - client->_written,
+                                           MSG_NOSIGNAL);
+
+                if (count < 0)
+                {
+                    closed = errno != EAGAIN && errno != EWOULDBLOCK;
+                    return;
+                }
+
+                client->_written += count;
+
+                if (client->_written < frame.size())
+                {
+                    return;
+                }
+
+                // A sent Close Frame ends the Connection.
+                if ((frame[0] & 0x0F) == WS_DISCONNECT)
+                {
+                    closing = true;
+                }
+
+                client->_queue.pop_front();
+                client->_written = 0;
+            }
+
+            if (client->_status == WS_DISCONNECTING)
+            {
+                closing = true;
+            }
+        }
+
+        if (closing)
+        {
+            closed = true;
+        }
+    }
+
+    /**
+     * Releases the socket and reports the disconnect of a WebSocket client.
+     */
+    void finish()
+    {
+        close(fd);
+
+        if (client == nullptr)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::recursive_mutex> guard(socket->_lock);
+
+            client->_status = WS_DISCONNECTING;
+            client->_queue.clear();
+        }
+
+        if (socket->_eventHandler)
+        {
+            socket->_eventHandler(socket, client, WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+        }
+
+        // From now on cleanupClients() may delete the Client.
+        std::lock_guard<std::recursive_mutex> guard(socket->_lock);
+
+        client->_status = WS_DISCONNECTED;
+    }
+
+    void upgrade(AsyncWebSocket* target, AsyncWebServerRequest* request)
+    {
+        const std::string key = std::string(request->header("Sec-WebSocket-Key").c_str()) +
+                                "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+        output += "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                  "Sec-WebSocket-Accept: " + base64(sha1(key)) + "\r\n\r\n";
+        request->_sent = true;
+
+        {
+            std::lock_guard<std::recursive_mutex> guard(target->_lock);
+
+            target->_clients.emplace_back(target, target->_nextId++);
+
+            client = &target->_clients.back();
+            socket = target;
+        }
+
+        if (socket->_eventHandler)
+        {
+            socket->_eventHandler(socket, client, WS_EVT_CONNECT, nullptr, nullptr, 0);
+        }
+    }
+
+    void respond(const std::string& response)
+    {
+        output += response;
+        closing = true;
+    }
+
+private:
+    bool write(std::string& data)
+    {
+        while (!data.empty())
+        {
+            const ssize_t count = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+
+            if (count < 0)
+            {
+                closed = errno != EAGAIN && errno != EWOULDBLOCK;
+                return false;
+            }
+
+            data.erase(0, count);
+        }
+
+        return true;
+    }
+
+    void parseRequest()
+    {
+        const size_t end = input.find("\r\n\r\n");
+
+        if (answered || end == std::string::npos)
+        {
+            return;
+        }
+
+        AsyncWebServerRequest request;
+        const std::string head = input.substr(0, end);
+
+        input.erase(0, end + 4);
+        answered = true;
+        request._connection = this;
+
+        // Request Line, e.g. "GET /path?query HTTP/1.1".
+        const size_t lineEnd = head.find("\r\n");
+        const std::string line = head.substr(0, lineEnd);
+        const size_t methodEnd = line.find(' ');
+        const size_t urlEnd = line.find(' ', methodEnd + 1);
+        std::string url = line.substr(methodEnd + 1, urlEnd - methodEnd - 1);
+
+        url = url.substr(0, url.find('?'));
+
+        const std::string method = line.substr(0, methodEnd);
+
+        request._method = method == "GET" ? HTTP_GET
+                          : method == "POST" ? HTTP_POST
+                          : method == "HEAD" ? HTTP_HEAD
+                          : method == "PUT" ? HTTP_PUT
+                          : method == "DELETE" ? HTTP_DELETE
+                          : HTTP_OPTIONS;
+        request._url = urlDecode(url.c_str());
+
+        for (size_t at = lineEnd; at != std::string::npos && at + 2 < head.size();)
+        {
+            const size_t next = head.find("\r\n", at + 2);
+            const std::string header = head.substr(at + 2, next == std::string::npos ? std::string::npos : next - at - 2);
+            const size_t colon = header.find(':');
+
+            if (colon != std::string::npos)
+            {
+                String value = header.substr(colon + 1).c_str();
+
+                value.trim();
+                request._headers.emplace_back(header.substr(0, colon).c_str(), value);
+            }
+
+            at = next;
+        }
+
+        for (AsyncWebHandler* handler : server->_handlers)
+        {
+            if (handler->filter(&request) && handler->canHandle(&request))
+            {
+                handler->handleRequest(&request);
+                break;
+            }
+        }
+
+        if (!request._sent)
+        {
+            request.send(404, "text/plain", "Not found");
+        }
+    }
+
+    void parseFrames()
+    {
+        for (;;)
+        {
+            if (input.size() < 2)
+            {
+                return;
+            }
+
+            const uint8_t* head = (const uint8_t*)input.data();
+            const bool final = head[0] & 0x80;
+            const uint8_t opcode = head[0] & 0x0F;
+            const bool masked = head[1] & 0x80;
+            uint64_t length = head[1] & 0x7F;
+            size_t offset = 2;
+
+            if (length == 126)
+            {
+                if (input.size() < 4)
+                {
+                    return;
+                }
+
+                length = head[2] << 8 | head[3];
+                offset = 4;
+            }
+            else if (length == 127)
+            {
+                if (input.size() < 10)
+                {
+                    return;
+                }
+
+                length = 0;
+
+                for (int i = 0; i < 8; i++)
+                {
+                    length = length << 8 | head[2 + i];
+                }
+
+                offset = 10;
+            }
+
+            if (length > MAX_INPUT)
+            {
+                closed = true;
+                return;
+            }
+
+            AwsFrameInfo info = {};
+
+            if (masked)
+            {
+                if (input.size() < offset + 4)
+                {
+                    return;
+                }
+
+                memcpy(info.mask, head + offset, 4);
+                offset += 4;
+            }
+
+            if (input.size() < offset + length)
+            {
+                return;
+            }
+
+            // Terminated Payload, the Library hands Text Frames out as C String as well.
+            std::vector<uint8_t> payload(input.begin() + offset, input.begin() + offset + length);
+
+            payload.push_back(0);
+            input.erase(0, offset + length);
+
+            if (masked)
+            {
+                for (size_t i = 0; i < length; i++)
+                {
+                    payload[i] ^= info.mask[i % 4];
+                }
+            }
+
+            if (opcode == WS_DISCONNECT)
+            {
+                client->close();
+                closing = true;
+            }
+            else if (opcode == WS_PING)
+            {
+                client->queueFrame(WS_PONG, payload.data(), length);
+            }
+            else if (opcode == WS_PONG)
+            {
+                if (socket->_eventHandler)
+                {
+                    socket->_eventHandler(socket, client, WS_EVT_PONG, nullptr, payload.data(), length);
+                }
+            }
+            else
+            {
+                if (opcode != WS_CONTINUATION)
+                {
+                    messageOpcode = opcode;
+                }
+
+                info.message_opcode = messageOpcode;
+                info.num = messageNumber;
+                info.final = final;
+                info.masked = masked;
+                info.opcode = opcode;
+                info.len = length;
+                info.index = 0;
+
+                if (final)
+                {
+                    messageNumber++;
+                }
+
+                if (socket->_eventHandler)
+                {
+                    socket->_eventHandler(socket, client, WS_EVT_DATA, &info, payload.data(), length);
+                }
+            }
+        }
+    }
+};
+
+bool AsyncWebServerResponse::addHeader(const char* name, const char* value, bool replaceExisting)
+{
+    for (AsyncWebHeader& header : _headers)
+    {
+        if (header.name().equalsIgnoreCase(name))
+        {
+            if (!replaceExisting)
+            {
+                return false;
+            }
+
+            header = AsyncWebHeader(name, value);
+            return true;
+        }
+    }
+
+    _headers.emplace_back(name, value);
+
+    return true;
+}
+
+const AsyncWebHeader* AsyncWebServerRequest::getHeader(const char* name) const
+{
+    for (const AsyncWebHeader& header : _headers)
+    {
+        if (header.name().equalsIgnoreCase(name))
+        {
+            return &header;
+        }
+    }
+
+    return nullptr;
+}
+
+String AsyncWebServerRequest::header(const char* name) const
+{
+    const AsyncWebHeader* header = getHeader(name);
+
+    return header != nullptr ? header->value() : String();
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const char* contentType, const String& content)
+{
+    auto* response = new AsyncWebServerResponse(code, contentType);
+
+    response->_content.assign(content.c_str(), content.length());
+
+    return response;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const char* contentType, const uint8_t* content,
+                                                             size_t len)
+{
+    auto* response = new AsyncWebServerResponse(code, contentType);
+
+    response->_content.assign((const char*)content, len);
+
+    return response;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(FS& fs, const String& path, const String& contentType,
+                                                             bool download)
+{
+    // Like the Library, a missing File is looked up with .gz Suffix.
+    const bool gzip = !fs.exists(path) && fs.exists(path + ".gz");
+    File file = fs.open(gzip ? path + ".gz" : path, FILE_READ);
+
+    if (!file)
+    {
+        return beginResponse(404, "text/plain", "Not found");
+    }
+
+    auto* response = new AsyncWebServerResponse(200, contentType.isEmpty() ? contentTypeOf(path) : contentType);
+    uint8_t buffer[1024];
+    size_t count;
+
+    while ((count = file.read(buffer, sizeof(buffer))) > 0)
+    {
+        response->_content.append((const char*)buffer, count);
+    }
+
+    file.close();
+
+    if (gzip)
+    {
+        response->addHeader("Content-Encoding", "gzip");
+    }
+
+    if (download)
+    {
+        response->addHeader("Content-Disposition", "attachment");
+    }
+
+    return response;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const char* contentType, AwsResponseFiller callback)
+{
+    auto* response = new AsyncWebServerResponse(200, contentType);
+
+    response->_filler = callback;
+    response->_chunked = true;
+
+    return response;
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response)
+{
+    if (_sent || _connection == nullptr)
+    {
+        delete response;
+        return;
+    }
+
+    _sent = true;
+
+    const bool body = response->_code >= 200 && response->_code != 204 && response->_code != 304 &&
+                      _method != HTTP_HEAD;
+    std::string head = "HTTP/1.1 " + std::to_string(response->_code) + " " + reasonPhrase(response->_code) + "\r\n";
+
+    head += "Connection: close\r\n";
+
+    if (!response->_contentType.isEmpty() && body)
+    {
+        head += std::string("Content-Type: ") + response->_contentType.c_str() + "\r\n";
+    }
+
+    for (const AsyncWebHeader& header : response->_headers)
+    {
+        head += std::string(header.name().c_str()) + ": " + header.value().c_str() + "\r\n";
+    }
+
+    std::string content;
+
+    if (response->_chunked)
+    {
+        // Pull the Body in Pieces, like the Library does while the Socket has Space.
+        uint8_t buffer[CHUNK];
+        size_t index = 0;
+        size_t count;
+
+        head += "Transfer-Encoding: chunked\r\n";
+
+        while (body && (count = response->_filler(buffer, sizeof(buffer), index)) > 0)
+        {
+            char size[20];
+
+            snprintf(size, sizeof(size), "%zx\r\n", count);
+
+            content += size;
+            content.append((const char*)buffer, count);
+            content += "\r\n";
+            index += count;
+        }
+
+        content += "0\r\n\r\n";
+    }
+    else
+    {
+        head += "Content-Length: " + std::to_string(body ? response->_content.size() : 0) + "\r\n";
+        content = body ? response->_content : "";
+    }
+
+    // The Response owns the Filler, deleting it releases what the Filler captured.
+    delete response;
+
+    _connection->respond(head + "\r\n" + content);
+}
+
+bool AsyncStaticWebHandler::canHandle(AsyncWebServerRequest* request) const
+{
+    const String& url = request->url();
+
+    return request->method() == HTTP_GET && url.startsWith(_uri) &&
+           (url.length() == _uri.length() || _uri.endsWith("/") || url[_uri.length()] == '/');
+}
+
+void AsyncStaticWebHandler::handleRequest(AsyncWebServerRequest* request)
+{
+    String path = _path + request->url().substring(_uri.length());
+
+    path.replace("//", "/");
+
+    if (path.endsWith("/"))
+    {
+        path += "index.htm";
+    }
+
+    if (!_fs.exists(path) && !_fs.exists(path + ".gz"))
+    {
+        request->send(404, "text/plain", "Not found");
+        return;
+    }
+
+    AsyncWebServerResponse* response = request->beginResponse(_fs, path);
+
+    if (!_cacheControl.isEmpty())
+    {
+        response->addHeader("Cache-Control", _cacheControl);
+    }
+
+    request->send(response);
+}
+
+bool AsyncWebSocketClient::queueFrame(uint8_t opcode, const uint8_t* data, size_t len)
+{
+    std::lock_guard<std::recursive_mutex> guard(_server->_lock);
+
+    if (_status != WS_CONNECTED)
+    {
+        return false;
+    }
+
+    if (opcode < WS_DISCONNECT && _queue.size() >= WS_MAX_QUEUED_MESSAGES)
+    {
+        if (_closeWhenFull)
+        {
+            Serial.printf("[host] Too many messages queued: closing client %u\n", (unsigned int)_id);
+            close();
+        }
+
+        return false;
+    }
+
+    // Server Frames are not masked.
+    std::vector<uint8_t> frame;
+
+    frame.reserve(len + 10);
+    frame.push_back(0x80 | opcode);
+
+    if (len < 126)
+    {
+        frame.push_back(len);
+    }
+    else if (len < 65536)
+    {
+        frame.push_back(126);
+        frame.push_back(len >> 8);
+        frame.push_back(len & 0xFF);
+    }
+    else
+    {
+        frame.push_back(127);
+
+        for (int shift = 56; shift >= 0; shift -= 8)
+        {
+            frame.push_back((uint64_t)len >> shift);
+        }
+    }
+
+    frame.insert(frame.end(), data, data + len);
+
+    _queue.push_back(std::move(frame));
+
+    if (_server->_wake)
+    {
+        _server->_wake();
+    }
+
+    return true;
+}
+
+void AsyncWebSocketClient::close(uint16_t code, const char* message)
+{
+    std::lock_guard<std::recursive_mutex> guard(_server->_lock);
+
+    if (_status != WS_CONNECTED)
+    {
+        return;
+    }
+
+    uint8_t payload[2] = {(uint8_t)(code >> 8), (uint8_t)(code & 0xFF)};
+
+    queueFrame(WS_DISCONNECT, payload, code != 0 ? 2 : 0);
+
+    _status = WS_DISCONNECTING;
+}
+
+size_t AsyncWebSocketClient::queueLen() const
+{
+    std::lock_guard<std::recursive_mutex> guard(_server->_lock);
+
+    return _queue.size();
+}
+
+AsyncWebSocketClient* AsyncWebSocket::client(uint32_t id)
+{
+    std::lock_guard<std::recursive_mutex> guard(_lock);
+
+    for (AsyncWebSocketClient& c : _clients)
+    {
+        if (c.id() == id && c.status() == WS_CONNECTED)
+        {
+            return &c;
+        }
+    }
+
+    return nullptr;
+}
+
+size_t AsyncWebSocket::count() const
+{
+    std::lock_guard<std::recursive_mutex> guard(_lock);
+    size_t connected = 0;
+
+    for (const AsyncWebSocketClient& c : _clients)
+    {
+        connected += c.status() == WS_CONNECTED ? 1 : 0;
+    }
+
+    return connected;
+}
+
+void AsyncWebSocket::cleanupClients(uint16_t maxClients)
+{
+    std::lock_guard<std::recursive_mutex> guard(_lock);
+
+    if (count() > maxClients)
+    {
+        for (AsyncWebSocketClient& c : _clients)
+        {
+            if (c.status() == WS_CONNECTED)
+            {
+                c.close();
+                break;
+            }
+        }
+    }
+
+    _clients.remove_if([](const AsyncWebSocketClient& c) { return c.status() == WS_DISCONNECTED; });
+}
+
+void AsyncWebSocket::closeAll(uint16_t code, const char* message)
+{
+    std::lock_guard<std::recursive_mutex> guard(_lock);
+
+    for (AsyncWebSocketClient& c : _clients)
+    {
+        c.close(code, message);
+    }
+}
+
+bool AsyncWebSocket::text(uint32_t id, const char* message)
+{
+    std::lock_guard<std::recursive_mutex> guard(_lock);
+    AsyncWebSocketClient* c = client(id);
+
+    return c != nullptr && c->text(message);
+}
+
+void AsyncWebSocket::textAll(const char* message)
+{
+    std::lock_guard<std::recursive_mutex> guard(_lock);
+
+    for (AsyncWebSocketClient& c : _clients)
+    {
+        c.text(message);
+    }
+}
+
+bool AsyncWebSocket::canHandle(AsyncWebServerRequest* request) const
+{
+    return request->method() == HTTP_GET && request->url() == _url &&
+           request->header("Upgrade").equalsIgnoreCase("websocket");
+}
+
+void AsyncWebSocket::handleRequest(AsyncWebServerRequest* request)
+{
+    request->_connection->upgrade(this, request);
+}
+
+AsyncWebServer::AsyncWebServer(uint16_t port) : _port(port)
+{
+    // Frames queued by other Threads wake the Network Thread.
+    if (pipe(_wake) == 0)
+    {
+        fcntl(_wake[0], F_SETFL, O_NONBLOCK);
+        fcntl(_wake[1], F_SETFL, O_NONBLOCK);
+    }
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, WebRequestMethod method, ArRequestHandlerFunction onRequest)
+{
+    auto* handler = new AsyncCallbackWebHandler(uri, method, onRequest);
+
+    _ownedHandlers.emplace_back(handler);
+    _handlers.push_back(handler);
+
+    return *handler;
+}
+
+AsyncStaticWebHandler& AsyncWebServer::serveStatic(const char* uri, FS& fs, const char* path, const char* cacheControl)
+{
+    auto* handler = new AsyncStaticWebHandler(uri, fs, path, cacheControl);
+
+    _ownedHandlers.emplace_back(handler);
+    _handlers.push_back(handler);
+
+    return *handler;
+}
+
+AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler)
+{
+    if (auto* socket = dynamic_cast<AsyncWebSocket*>(handler))
+    {
+        const int wake = _wake[1];
+
+        socket->_wake = [wake]
+        {
+            const char signal = 1;
+
+            (void)!::write(wake, &signal, 1);
+        };
+    }
+
+    _handlers.push_back(handler);
+
+    return *handler;
+}
+
+void AsyncWebServer::begin()
+{
+    const int listener = socket(AF_INET, SOCK_STREAM, 0);
+    const int enable = 1;
+    sockaddr_in address = {};
+
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(hostServerPort != 0 ? hostServerPort : _port);
+
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 64) != 0)
+    {
+        Serial.printf("[host] Unable to listen on port %u: %s\n", ntohs(address.sin_port), strerror(errno));
+        exit(1);
+    }
+
+    fcntl(listener, F_SETFL, O_NONBLOCK);
+
+    Serial.printf("[host] Listening on http://127.0.0.1:%u\n", ntohs(address.sin_port));
+
+    _thread = std::thread(&AsyncWebServer::run, this, listener);
+    _thread.detach();
+}
+
+void AsyncWebServer::run(int listener)
+{
+    std::vector<std::unique_ptr<HostConnection>> connections;
+
+    for (;;)
+    {
+        std::vector<pollfd> fds;
+
+        fds.push_back({_wake[0], POLLIN, 0});
+        fds.push_back({listener, POLLIN, 0});
+
+        for (auto& connection : connections)
+        {
+            fds.push_back({connection->fd, (short)(POLLIN | (connection->wantsWrite() ? POLLOUT : 0)), 0});
+        }
+
+        poll(fds.data(), fds.size(), 100);
+
+        char drain[64];
+
+        while (read(_wake[0], drain, sizeof(drain)) > 0)
+        {
+        }
+
+        int fd;
+
+        while ((fd = accept(listener, nullptr, nullptr)) >= 0)
+        {
+            const int enable = 1;
+
+            fcntl(fd, F_SETFL, O_NONBLOCK);
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+            connections.emplace_back(new HostConnection(this, fd));
+        }
+
+        for (size_t i = 0; i < connections.size(); i++)
+        {
+            if (i + 2 < fds.size() && fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                connections[i]->receive();
+            }
+
+            if (!connections[i]->closed)
+            {
+                connections[i]->flush();
+            }
+        }
+
+        for (size_t i = 0; i < connections.size();)
+        {
+            if (connections[i]->closed)
+            {
+                connections[i]->finish();
+                connections.erase(connections.begin() + i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+}
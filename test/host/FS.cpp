@@ -0,0 +1,173 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <FS.h>
+#include <SPIFFS.h>
+
+#include <sys/stat.h>
+
+SPIFFSFS SPIFFS;
+
+namespace
+{
+    /**
+     * Creates the parent directories of a host path, like `mkdir -p`.
+     */
+    void createParents(const String& path)
+    {
+        for (int slash = path.indexOf('/', 1); slash > 0; slash = path.indexOf('/', slash + 1))
+        {
+            ::mkdir(path.substring(0, slash).c_str(), 0755);
+        }
+    }
+}
+
+namespace fs
+{
+    File::File(FILE* file, const String& path) : handle(file, fclose), path(path)
+    {
+    }
+
+    size_t File::write(uint8_t c)
+    {
+        return handle && fputc(c, handle.get()) != EOF ? 1 : 0;
+    }
+
+    size_t File::write(const uint8_t* buffer, size_t size)
+    {
+        return handle ? fwrite(buffer, 1, size, handle.get()) : 0;
+    }
+
+    size_t File::read(uint8_t* buffer, size_t size)
+    {
+        return handle ? fread(buffer, 1, size, handle.get()) : 0;
+    }
+
+    int File::read()
+    {
+        return handle ? fgetc(handle.get()) : -1;
+    }
+
+    int File::peek()
+    {
+        if (!handle)
+        {
+            return -1;
+        }
+
+        const int c = fgetc(handle.get());
+
+        if (c != EOF)
+        {
+            ungetc(c, handle.get());
+        }
+
+        return c;
+    }
+
+    int File::available()
+    {
+        return handle ? size() - position() : 0;
+    }
+
+    size_t File::size() const
+    {
+        if (!handle)
+        {
+            return 0;
+        }
+
+        fflush(handle.get());
+
+        struct stat info;
+
+        return fstat(fileno(handle.get()), &info) == 0 ? info.st_size : 0;
+    }
+
+    size_t File::position() const
+    {
+        return handle ? ftell(handle.get()) : 0;
+    }
+
+    bool File::seek(uint32_t position)
+    {
+        return handle && fseek(handle.get(), position, SEEK_SET) == 0;
+    }
+
+    void File::flush()
+    {
+        if (handle)
+        {
+            fflush(handle.get());
+        }
+    }
+
+    void File::close()
+    {
+        handle.reset();
+    }
+
+    const char* File::name() const
+    {
+        const int slash = path.lastIndexOf('/');
+
+        return path.c_str() + slash + 1;
+    }
+
+    String FS::hostPath(const String& path) const
+    {
+        return root + (path.startsWith("/") ? "" : "/") + path;
+    }
+
+    File FS::open(const char* path, const char* mode, bool create)
+    {
+        const String target = hostPath(path);
+
+        // Writing creates missing Directories, SPIFFS has none at all.
+        if (mode[0] != 'r')
+        {
+            createParents(target);
+        }
+
+        FILE* file = fopen(target.c_str(), mode[0] == 'a' ? "ab+" : mode[0] == 'w' ? "wb+" : "rb");
+
+        return file != nullptr ? File(file, path) : File();
+    }
+
+    bool FS::exists(const char* path)
+    {
+        struct stat info;
+
+        return stat(hostPath(path).c_str(), &info) == 0;
+    }
+
+    bool FS::remove(const char* path)
+    {
+        return ::remove(hostPath(path).c_str()) == 0;
+    }
+
+    bool FS::rename(const char* from, const char* to)
+    {
+        createParents(hostPath(to));
+
+        return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+    }
+
+    bool FS::mkdir(const char* path)
+    {
+        const String target = hostPath(path);
+
+        createParents(target + "/");
+
+        struct stat info;
+
+        return stat(target.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    }
+}
+
+bool SPIFFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* partitionLabel)
+{
+    // Mounting creates the Directory, like formatting an empty Partition.
+    return mkdir("/");
+}
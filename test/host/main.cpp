@@ -0,0 +1,92 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Host entry point: runs a sketch (setup() and loop()) as a Linux process, so that
+// scripts/loadtest.py can be run without a device, e.g.:
+//   pio run -e native && .pio/build/native/program --port 8080 --fs /tmp/bf-fs --data data
+//   python scripts/loadtest.py --host 127.0.0.1 --port 8080 --clients 8 --duration 30
+//
+// Options:
+//   --port <port>  Port to listen on instead of the one of the sketch (default 8080).
+//   --fs <dir>     Directory SPIFFS is mounted from (default ./host-fs).
+//   --data <dir>   Copies the files of the directory into SPIFFS first, like uploadfs (e.g. data).
+//   --heap <kb>    Heap size reported to the sketch (default 320).
+//
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <SPIFFS.h>
+
+#include <csignal>
+#include <filesystem>
+
+void setup();
+void loop();
+
+extern uint32_t hostHeapSize;
+void hostResetHeap();
+
+int main(int argc, char** argv)
+{
+    const char* data = nullptr;
+
+    hostServerPort = 8080;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const String option = argv[i];
+
+        if (option == "--port")
+        {
+            hostServerPort = atoi(argv[i + 1]);
+        }
+        else if (option == "--fs")
+        {
+            SPIFFS.setRoot(argv[i + 1]);
+        }
+        else if (option == "--data")
+        {
+            data = argv[i + 1];
+        }
+        else if (option == "--heap")
+        {
+            hostHeapSize = atoi(argv[i + 1]) * 1024;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (data != nullptr)
+    {
+        std::error_code error;
+
+        std::filesystem::create_directories(SPIFFS.getRoot().c_str(), error);
+        std::filesystem::copy(data, SPIFFS.getRoot().c_str(),
+                              std::filesystem::copy_options::recursive |
+                              std::filesystem::copy_options::overwrite_existing, error);
+
+        if (error)
+        {
+            fprintf(stderr, "Unable to copy %s: %s\n", data, error.message().c_str());
+            return 1;
+        }
+    }
+
+    // Serial Output reaches Pipes line by line, like the Serial Monitor.
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    // Closed Sockets are reported by send(), not by a Signal.
+    signal(SIGPIPE, SIG_IGN);
+
+    hostResetHeap();
+
+    setup();
+
+    for (;;)
+    {
+        loop();
+    }
+}
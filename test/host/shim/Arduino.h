@@ -0,0 +1,359 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Host stand-in for the parts of the ESP32 Arduino core used by ByteFramework:
+// String, timing, Serial, esp_random, heap statistics and the FreeRTOS task notifications
+// of the pipeline mode. Only meant for the native build, see test/host/main.cpp.
+//
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <functional>
+
+#define F(string) (string)
+#define IRAM_ATTR
+
+class __FlashStringHelper;
+
+/**
+ * @brief Arduino String on top of std::string, with the constructor set of the ESP32 core.
+ */
+class String
+{
+private:
+    std::string buffer;
+
+public:
+    String(const char* cstr = "") : buffer(cstr != nullptr ? cstr : "") {}
+    String(const char* cstr, unsigned int length) : buffer(cstr, length) {}
+    String(const uint8_t* cstr, unsigned int length) : buffer((const char*)cstr, length) {}
+    String(const String& str) = default;
+    String(const __FlashStringHelper* str) : String((const char*)str) {}
+    String(String&& rval) noexcept = default;
+    explicit String(char c) : buffer(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) : String((unsigned long)value, base) {}
+    explicit String(int value, unsigned char base = 10) : String((long)value, base) {}
+    explicit String(unsigned int value, unsigned char base = 10) : String((unsigned long)value, base) {}
+    explicit String(long value, unsigned char base = 10) : String((long long)value, base) {}
+    explicit String(unsigned long value, unsigned char base = 10) : String((unsigned long long)value, base) {}
+    explicit String(float value, unsigned int decimalPlaces = 2) : String((double)value, decimalPlaces) {}
+
+    explicit String(double value, unsigned int decimalPlaces = 2)
+    {
+        char text[48];
+
+        snprintf(text, sizeof(text), "%.*f", (int)decimalPlaces, value);
+        buffer = text;
+    }
+
+    explicit String(long long value, unsigned char base = 10)
+    {
+        if (value < 0)
+        {
+            buffer = "-" + String((unsigned long long)-value, base).buffer;
+        }
+        else
+        {
+            buffer = String((unsigned long long)value, base).buffer;
+        }
+    }
+
+    explicit String(unsigned long long value, unsigned char base = 10)
+    {
+        const char* digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+        do
+        {
+            buffer.insert(buffer.begin(), digits[value % base]);
+            value /= base;
+        }
+        while (value > 0);
+    }
+
+    String& operator=(const String& rhs) = default;
+    String& operator=(String&& rhs) noexcept = default;
+
+    String& operator=(const char* cstr)
+    {
+        buffer = cstr != nullptr ? cstr : "";
+        return *this;
+    }
+
+    const char* c_str() const { return buffer.c_str(); }
+    unsigned int length() const { return buffer.length(); }
+    bool isEmpty() const { return buffer.empty(); }
+    bool reserve(unsigned int size) { buffer.reserve(size); return true; }
+    void clear() { buffer.clear(); }
+
+    bool concat(const String& str) { buffer += str.buffer; return true; }
+    bool concat(const char* cstr) { if (cstr == nullptr) return false; buffer += cstr; return true; }
+    bool concat(const char* cstr, unsigned int length) { if (cstr == nullptr) return false; buffer.append(cstr, length); return true; }
+    bool concat(const uint8_t* cstr, unsigned int length) { return concat((const char*)cstr, length); }
+    bool concat(char c) { buffer += c; return true; }
+    bool concat(unsigned char value) { return concat(String(value)); }
+    bool concat(int value) { return concat(String(value)); }
+    bool concat(unsigned int value) { return concat(String(value)); }
+    bool concat(long value) { return concat(String(value)); }
+    bool concat(unsigned long value) { return concat(String(value)); }
+    bool concat(long long value) { return concat(String(value)); }
+    bool concat(unsigned long long value) { return concat(String(value)); }
+    bool concat(float value) { return concat(String(value)); }
+    bool concat(double value) { return concat(String(value)); }
+
+    template <typename T>
+    String& operator+=(const T& value)
+    {
+        concat(value);
+        return *this;
+    }
+
+    char operator[](unsigned int index) const { return index < buffer.length() ? buffer[index] : 0; }
+    char& operator[](unsigned int index) { return buffer[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+    void setCharAt(unsigned int index, char c) { if (index < buffer.length()) buffer[index] = c; }
+
+    int compareTo(const String& s) const { return buffer.compare(s.buffer); }
+    bool equals(const String& s) const { return buffer == s.buffer; }
+    bool equals(const char* cstr) const { return buffer == (cstr != nullptr ? cstr : ""); }
+
+    bool equalsIgnoreCase(const String& s) const
+    {
+        if (buffer.length() != s.buffer.length())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < buffer.length(); i++)
+        {
+            if (tolower((unsigned char)buffer[i]) != tolower((unsigned char)s.buffer[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool operator==(const String& rhs) const { return equals(rhs); }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& rhs) const { return !equals(rhs); }
+    bool operator!=(const char* cstr) const { return !equals(cstr); }
+    bool operator<(const String& rhs) const { return buffer < rhs.buffer; }
+    bool operator>(const String& rhs) const { return buffer > rhs.buffer; }
+    bool operator<=(const String& rhs) const { return buffer <= rhs.buffer; }
+    bool operator>=(const String& rhs) const { return buffer >= rhs.buffer; }
+
+    bool startsWith(const String& prefix) const { return buffer.compare(0, prefix.buffer.length(), prefix.buffer) == 0; }
+
+    bool startsWith(const String& prefix, unsigned int offset) const
+    {
+        return offset <= buffer.length() && buffer.compare(offset, prefix.buffer.length(), prefix.buffer) == 0;
+    }
+
+    bool endsWith(const String& suffix) const
+    {
+        return buffer.length() >= suffix.buffer.length() &&
+               buffer.compare(buffer.length() - suffix.buffer.length(), suffix.buffer.length(), suffix.buffer) == 0;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const { return position(buffer.find(c, from)); }
+    int indexOf(const String& str, unsigned int from = 0) const { return position(buffer.find(str.buffer, from)); }
+    int lastIndexOf(char c) const { return position(buffer.rfind(c)); }
+    int lastIndexOf(const String& str) const { return position(buffer.rfind(str.buffer)); }
+
+    String substring(unsigned int beginIndex) const
+    {
+        return beginIndex < buffer.length() ? String(buffer.c_str() + beginIndex) : String();
+    }
+
+    String substring(unsigned int beginIndex, unsigned int endIndex) const
+    {
+        if (beginIndex > endIndex)
+        {
+            std::swap(beginIndex, endIndex);
+        }
+
+        if (beginIndex >= buffer.length())
+        {
+            return String();
+        }
+
+        endIndex = endIndex < buffer.length() ? endIndex : buffer.length();
+
+        return String(buffer.c_str() + beginIndex, endIndex - beginIndex);
+    }
+
+    void replace(char find, char replacement)
+    {
+        for (char& c : buffer)
+        {
+            if (c == find)
+            {
+                c = replacement;
+            }
+        }
+    }
+
+    void replace(const String& find, const String& replacement)
+    {
+        if (find.isEmpty())
+        {
+            return;
+        }
+
+        size_t at = 0;
+
+        while ((at = buffer.find(find.buffer, at)) != std::string::npos)
+        {
+            buffer.replace(at, find.buffer.length(), replacement.buffer);
+            at += replacement.buffer.length();
+        }
+    }
+
+    void remove(unsigned int index) { if (index < buffer.length()) buffer.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < buffer.length()) buffer.erase(index, count); }
+
+    void toLowerCase() { for (char& c : buffer) c = tolower((unsigned char)c); }
+    void toUpperCase() { for (char& c : buffer) c = toupper((unsigned char)c); }
+
+    void trim()
+    {
+        const size_t first = buffer.find_first_not_of(" \t\r\n");
+
+        if (first == std::string::npos)
+        {
+            buffer.clear();
+            return;
+        }
+
+        buffer = buffer.substr(first, buffer.find_last_not_of(" \t\r\n") - first + 1);
+    }
+
+    long toInt() const { return atol(buffer.c_str()); }
+    float toFloat() const { return atof(buffer.c_str()); }
+    double toDouble() const { return atof(buffer.c_str()); }
+
+private:
+    static int position(size_t at) { return at == std::string::npos ? -1 : (int)at; }
+};
+
+/**
+ * @brief Result of a concatenation, ArduinoJson adapts it like String.
+ */
+class StringSumHelper : public String
+{
+public:
+    StringSumHelper(const String& s) : String(s) {}
+    StringSumHelper(const char* p) : String(p) {}
+};
+
+template <typename T>
+inline StringSumHelper operator+(const String& lhs, const T& rhs)
+{
+    StringSumHelper result(lhs);
+
+    result.concat(rhs);
+
+    return result;
+}
+
+inline StringSumHelper operator+(const char* lhs, const String& rhs)
+{
+    StringSumHelper result(lhs);
+
+    result.concat(rhs);
+
+    return result;
+}
+
+/**
+ * @brief Serial port, printed to stdout.
+ */
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud) {}
+
+    size_t write(uint8_t c) { return fputc(c, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t* buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+
+    size_t print(const String& s) { return fputs(s.c_str(), stdout) < 0 ? 0 : s.length(); }
+    size_t print(const char* s) { return print(String(s)); }
+    size_t print(char c) { return write(c); }
+
+    template <typename T>
+    size_t print(T value) { return print(String(value)); }
+
+    template <typename T>
+    size_t println(T value) { const size_t n = print(value); return n + println(); }
+
+    size_t println() { fputc('\n', stdout); fflush(stdout); return 1; }
+
+    template <typename... Args>
+    size_t printf(const char* format, Args... args) { return ::printf(format, args...); }
+};
+
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+long random(long max);
+long random(long min, long max);
+uint32_t esp_random();
+
+/**
+ * @brief Heap statistics of the process, reported in the units of the ESP32 heap.
+ *
+ * All allocations since setup() count against a fixed heap size (default 320 KB, see
+ * test/host/main.cpp), so admission control and the stats packet behave like on a device.
+ */
+class EspClass
+{
+public:
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+};
+
+extern EspClass ESP;
+
+/**
+ * FreeRTOS subset used by the pipeline mode, tasks are threads.
+ */
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void*);
+typedef struct HostTask* TaskHandle_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define PRO_CPU_NUM 0
+#define APP_CPU_NUM 1
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+
+#endif
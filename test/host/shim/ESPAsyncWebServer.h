@@ -0,0 +1,359 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Host stand-in for ESPAsyncWebServer: a loopback HTTP and WebSocket server on real TCP
+// sockets. All handlers and WebSocket events run on one network thread, like the AsyncTCP
+// task on the device. Frames queued from other threads wait in a per-client queue of at most
+// WS_MAX_QUEUED_MESSAGES entries, which is what queueLen() reports.
+//
+
+#ifndef HOST_ESPASYNCWEBSERVER_H
+#define HOST_ESPASYNCWEBSERVER_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define WS_MAX_QUEUED_MESSAGES 32
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+class AsyncWebSocket;
+class AsyncWebSocketClient;
+class HostConnection;
+
+typedef enum
+{
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111
+} WebRequestMethod;
+
+typedef enum
+{
+    WS_EVT_CONNECT,
+    WS_EVT_DISCONNECT,
+    WS_EVT_PING,
+    WS_EVT_PONG,
+    WS_EVT_ERROR,
+    WS_EVT_DATA
+} AwsEventType;
+
+typedef enum
+{
+    WS_CONTINUATION,
+    WS_TEXT,
+    WS_BINARY,
+    WS_DISCONNECT = 0x08,
+    WS_PING,
+    WS_PONG
+} AwsFrameType;
+
+typedef enum
+{
+    WS_DISCONNECTED,
+    WS_CONNECTED,
+    WS_DISCONNECTING
+} AwsClientStatus;
+
+typedef struct
+{
+    uint8_t message_opcode;
+    uint32_t num;
+    uint8_t final;
+    uint8_t masked;
+    uint8_t opcode;
+    uint64_t len;
+    uint8_t mask[4];
+    uint64_t index;
+} AwsFrameInfo;
+
+using AsyncWebSocketSharedBuffer = std::shared_ptr<std::vector<uint8_t>>;
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<bool(AsyncWebServerRequest* request)> ArRequestFilterFunction;
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<void(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg,
+                           uint8_t* data, size_t len)> AwsEventHandler;
+
+class AsyncWebHeader
+{
+private:
+    String _name;
+    String _value;
+
+public:
+    AsyncWebHeader(const String& name, const String& value) : _name(name), _value(value) {}
+
+    const String& name() const { return _name; }
+    const String& value() const { return _value; }
+};
+
+/**
+ * @brief A response, written to the connection as a whole when it is sent.
+ */
+class AsyncWebServerResponse
+{
+    friend class AsyncWebServerRequest;
+
+private:
+    int _code;
+    String _contentType;
+    std::string _content;
+    AwsResponseFiller _filler;
+    bool _chunked = false;
+    std::vector<AsyncWebHeader> _headers;
+
+public:
+    AsyncWebServerResponse(int code, const String& contentType) : _code(code), _contentType(contentType) {}
+    virtual ~AsyncWebServerResponse() = default;
+
+    void setCode(int code) { _code = code; }
+    void setContentType(const String& type) { _contentType = type; }
+    void setContentLength(size_t length) {}
+
+    bool addHeader(const char* name, const char* value, bool replaceExisting = true);
+    bool addHeader(const String& name, const String& value, bool replaceExisting = true)
+    {
+        return addHeader(name.c_str(), value.c_str(), replaceExisting);
+    }
+};
+
+/**
+ * @brief A parsed HTTP request, valid while its handler runs.
+ */
+class AsyncWebServerRequest
+{
+    friend class AsyncWebSocket;
+    friend class HostConnection;
+
+private:
+    WebRequestMethod _method = HTTP_GET;
+    String _url;
+    std::vector<AsyncWebHeader> _headers;
+    HostConnection* _connection = nullptr;
+    bool _sent = false;
+    std::function<void()> _onDisconnect;
+
+public:
+    WebRequestMethod method() const { return _method; }
+    const String& url() const { return _url; }
+
+    bool hasHeader(const char* name) const { return getHeader(name) != nullptr; }
+    const AsyncWebHeader* getHeader(const char* name) const;
+    String header(const char* name) const;
+
+    AsyncWebServerResponse* beginResponse(int code, const char* contentType = "", const String& content = "");
+    AsyncWebServerResponse* beginResponse(int code, const String& contentType, const String& content = "")
+    {
+        return beginResponse(code, contentType.c_str(), content);
+    }
+    AsyncWebServerResponse* beginResponse(int code, const char* contentType, const uint8_t* content, size_t len);
+    AsyncWebServerResponse* beginResponse(FS& fs, const String& path, const String& contentType = String(),
+                                          bool download = false);
+    AsyncWebServerResponse* beginChunkedResponse(const char* contentType, AwsResponseFiller callback);
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller callback)
+    {
+        return beginChunkedResponse(contentType.c_str(), callback);
+    }
+
+    void send(AsyncWebServerResponse* response);
+    void send(int code, const char* contentType = "", const String& content = "")
+    {
+        send(beginResponse(code, contentType, content));
+    }
+    void send(int code, const String& contentType, const String& content = "")
+    {
+        send(beginResponse(code, contentType, content));
+    }
+
+    void onDisconnect(std::function<void()> callback) { _onDisconnect = callback; }
+};
+
+class AsyncWebHandler
+{
+protected:
+    ArRequestFilterFunction _filter;
+
+public:
+    virtual ~AsyncWebHandler() = default;
+
+    AsyncWebHandler& setFilter(ArRequestFilterFunction fn)
+    {
+        _filter = fn;
+        return *this;
+    }
+
+    bool filter(AsyncWebServerRequest* request) { return _filter == nullptr || _filter(request); }
+
+    virtual bool canHandle(AsyncWebServerRequest* request) const { return false; }
+    virtual void handleRequest(AsyncWebServerRequest* request) {}
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler
+{
+private:
+    String _uri;
+    WebRequestMethod _method;
+    ArRequestHandlerFunction _onRequest;
+
+public:
+    AsyncCallbackWebHandler(const String& uri, WebRequestMethod method, ArRequestHandlerFunction onRequest)
+        : _uri(uri), _method(method), _onRequest(onRequest)
+    {
+    }
+
+    bool canHandle(AsyncWebServerRequest* request) const override
+    {
+        return (request->method() & _method) && request->url() == _uri;
+    }
+
+    void handleRequest(AsyncWebServerRequest* request) override { _onRequest(request); }
+};
+
+class AsyncStaticWebHandler : public AsyncWebHandler
+{
+private:
+    String _uri;
+    FS& _fs;
+    String _path;
+    String _cacheControl;
+
+public:
+    AsyncStaticWebHandler(const String& uri, FS& fs, const String& path, const char* cacheControl)
+        : _uri(uri), _fs(fs), _path(path), _cacheControl(cacheControl != nullptr ? cacheControl : "")
+    {
+    }
+
+    AsyncStaticWebHandler& setCacheControl(const char* cacheControl)
+    {
+        _cacheControl = cacheControl;
+        return *this;
+    }
+
+    bool canHandle(AsyncWebServerRequest* request) const override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+};
+
+/**
+ * @brief A WebSocket client. The object stays in the client list after the
+ * connection closed, until AsyncWebSocket::cleanupClients() removes it.
+ */
+class AsyncWebSocketClient
+{
+    friend class AsyncWebSocket;
+    friend class HostConnection;
+
+private:
+    AsyncWebSocket* _server;
+    uint32_t _id;
+    AwsClientStatus _status = WS_CONNECTED;
+    bool _closeWhenFull = true;
+
+    /**
+     * Encoded frames not completely written to the socket yet, guarded by the server lock.
+     */
+    std::deque<std::vector<uint8_t>> _queue;
+    size_t _written = 0;
+
+    bool queueFrame(uint8_t opcode, const uint8_t* data, size_t len);
+
+public:
+    AsyncWebSocketClient(AsyncWebSocket* server, uint32_t id) : _server(server), _id(id) {}
+
+    uint32_t id() const { return _id; }
+    AwsClientStatus status() const { return _status; }
+    AsyncWebSocket* server() { return _server; }
+
+    bool text(const uint8_t* message, size_t len) { return queueFrame(WS_TEXT, message, len); }
+    bool text(const char* message, size_t len) { return text((const uint8_t*)message, len); }
+    bool text(const char* message) { return text(message, strlen(message)); }
+    bool text(const String& message) { return text(message.c_str(), message.length()); }
+    bool text(AsyncWebSocketSharedBuffer buffer) { return text(buffer->data(), buffer->size()); }
+
+    bool ping(const uint8_t* data = nullptr, size_t len = 0) { return queueFrame(WS_PING, data, len); }
+    void close(uint16_t code = 0, const char* message = nullptr);
+
+    size_t queueLen() const;
+    bool queueIsFull() const { return queueLen() >= WS_MAX_QUEUED_MESSAGES; }
+    bool canSend() const { return !queueIsFull(); }
+    void setCloseClientOnQueueFull(bool close) { _closeWhenFull = close; }
+};
+
+class AsyncWebSocket : public AsyncWebHandler
+{
+    friend class AsyncWebServer;
+    friend class AsyncWebSocketClient;
+    friend class HostConnection;
+
+private:
+    String _url;
+    AwsEventHandler _eventHandler;
+    std::list<AsyncWebSocketClient> _clients;
+    uint32_t _nextId = 1;
+    mutable std::recursive_mutex _lock;
+    std::function<void()> _wake;
+
+public:
+    explicit AsyncWebSocket(const String& url) : _url(url) {}
+
+    const char* url() const { return _url.c_str(); }
+    void onEvent(AwsEventHandler handler) { _eventHandler = handler; }
+
+    std::list<AsyncWebSocketClient>& getClients() { return _clients; }
+    AsyncWebSocketClient* client(uint32_t id);
+    size_t count() const;
+    void cleanupClients(uint16_t maxClients = 8);
+    void closeAll(uint16_t code = 0, const char* message = nullptr);
+
+    bool text(uint32_t id, const char* message);
+    bool text(uint32_t id, const String& message) { return text(id, message.c_str()); }
+    void textAll(const char* message);
+    void textAll(const String& message) { textAll(message.c_str()); }
+
+    bool canHandle(AsyncWebServerRequest* request) const override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+};
+
+/**
+ * Port the host build listens on instead of the one passed to AsyncWebServer, 0 keeps it.
+ */
+extern uint16_t hostServerPort;
+
+class AsyncWebServer
+{
+    friend class HostConnection;
+
+private:
+    uint16_t _port;
+    int _wake[2] = {-1, -1};
+    std::vector<std::unique_ptr<AsyncWebHandler>> _ownedHandlers;
+    std::vector<AsyncWebHandler*> _handlers;
+    std::thread _thread;
+
+    void run(int listener);
+
+public:
+    explicit AsyncWebServer(uint16_t port);
+
+    void begin();
+
+    AsyncCallbackWebHandler& on(const char* uri, WebRequestMethod method, ArRequestHandlerFunction onRequest);
+    AsyncStaticWebHandler& serveStatic(const char* uri, FS& fs, const char* path, const char* cacheControl = nullptr);
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler);
+};
+
+#endif
@@ -0,0 +1,87 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Host stand-in for the Arduino filesystem API, backed by a directory of the host.
+//
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <Arduino.h>
+#include <memory>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+    /**
+     * @brief An open file, copies share the handle like on the device.
+     */
+    class File
+    {
+    private:
+        std::shared_ptr<FILE> handle;
+        String path;
+
+    public:
+        File() = default;
+        File(FILE* file, const String& path);
+
+        size_t write(uint8_t c);
+        size_t write(const uint8_t* buffer, size_t size);
+        size_t read(uint8_t* buffer, size_t size);
+        size_t readBytes(char* buffer, size_t length) { return read((uint8_t*)buffer, length); }
+        int read();
+        int peek();
+        int available();
+        size_t size() const;
+        size_t position() const;
+        bool seek(uint32_t position);
+        void flush();
+        void close();
+        const char* name() const;
+
+        explicit operator bool() const { return handle != nullptr; }
+    };
+
+    /**
+     * @brief A filesystem rooted in a directory of the host.
+     *
+     * Like SPIFFS it has no real directories: writing a path creates the missing
+     * directories on the host.
+     */
+    class FS
+    {
+    protected:
+        String root;
+
+    public:
+        explicit FS(const String& root) : root(root) {}
+
+        void setRoot(const String& directory) { root = directory; }
+        const String& getRoot() const { return root; }
+
+        /**
+         * @brief Maps a path of the filesystem to a path on the host.
+         */
+        String hostPath(const String& path) const;
+
+        File open(const char* path, const char* mode = FILE_READ, bool create = false);
+        File open(const String& path, const char* mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+        bool exists(const char* path);
+        bool exists(const String& path) { return exists(path.c_str()); }
+        bool remove(const char* path);
+        bool remove(const String& path) { return remove(path.c_str()); }
+        bool rename(const char* from, const char* to);
+        bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+        bool mkdir(const char* path);
+        bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    };
+}
+
+using fs::FS;
+using fs::File;
+
+#endif
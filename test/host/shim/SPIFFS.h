@@ -0,0 +1,24 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Host stand-in for SPIFFS, see test/host/main.cpp for the directory it is mounted from.
+//
+
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+#include <FS.h>
+
+class SPIFFSFS : public fs::FS
+{
+public:
+    SPIFFSFS() : fs::FS("host-fs") {}
+
+    bool begin(bool formatOnFail = false, const char* basePath = "/spiffs", uint8_t maxOpenFiles = 10,
+               const char* partitionLabel = nullptr);
+    void end() {}
+};
+
+extern SPIFFSFS SPIFFS;
+
+#endif
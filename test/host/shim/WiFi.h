@@ -0,0 +1,33 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+// Host stand-in for the WiFi library, the host is already connected.
+//
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+
+typedef enum
+{
+    WIFI_OFF,
+    WIFI_STA,
+    WIFI_AP,
+    WIFI_AP_STA
+} wifi_mode_t;
+
+class WiFiClass
+{
+public:
+    bool mode(wifi_mode_t mode) { return true; }
+    bool softAP(const char* ssid, const char* passphrase = nullptr) { return true; }
+    int begin(const char* ssid, const char* passphrase = nullptr) { return 3; }
+    int status() { return 3; }
+};
+
+inline WiFiClass WiFi;
+
+#define WL_CONNECTED 3
+
+#endif